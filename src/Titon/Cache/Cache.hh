@@ -132,6 +132,19 @@ class Cache {
         return $this->getStorage($storage)->increment($key, $step, $initial);
     }
 
+    /**
+     * Invalidate all items persisted with any of the tags, without flushing the storage engine.
+     *
+     * @param array<string> $tags
+     * @param string $storage
+     * @return $this
+     */
+    public function invalidateTags(array<string> $tags, string $storage = 'default'): this {
+        $this->getStorage($storage)->invalidateTags($tags);
+
+        return $this;
+    }
+
     /**
      * Remove the item if it exists and return true, else return false.
      *
@@ -175,10 +188,11 @@ class Cache {
      * @param \Titon\Cache\CacheCallback $callback
      * @param mixed $expires
      * @param string $storage
+     * @param array<string> $tags
      * @return mixed
      */
-    public function store(string $key, CacheCallback $callback, mixed $expires = null, string $storage = 'default'): mixed {
-        return $this->getStorage($storage)->store($key, $callback, $expires);
+    public function store(string $key, CacheCallback $callback, mixed $expires = null, string $storage = 'default', array<string> $tags = []): mixed {
+        return $this->getStorage($storage)->store($key, $callback, $expires, $tags);
     }
 
 }
\ No newline at end of file
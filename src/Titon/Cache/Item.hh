@@ -32,6 +32,13 @@ class Item {
      */
     protected string $_key = '';
 
+    /**
+     * Tags the item is persisted with.
+     *
+     * @var array<string>
+     */
+    protected array<string> $_tags = [];
+
     /**
      * The items value to be saved.
      *
@@ -108,6 +115,15 @@ class Item {
         return $this->_key;
     }
 
+    /**
+     * Return the tags the item is persisted with.
+     *
+     * @return array<string>
+     */
+    public function getTags(): array<string> {
+        return $this->_tags;
+    }
+
     /**
      * Confirms if the cache item lookup resulted in a cache hit.
      *
@@ -185,4 +201,17 @@ class Item {
         return $this;
     }
 
+    /**
+     * Set the tags the item is persisted with. Invalidating any of the tags invalidates the item.
+     * Tags are namespaced by dots, so invalidating `user.5` also invalidates an item tagged with `user.5.views`.
+     *
+     * @param array<string> $tags
+     * @return $this
+     */
+    public function setTags(array<string> $tags): this {
+        $this->_tags = array_values(array_unique($tags));
+
+        return $this;
+    }
+
 }
\ No newline at end of file
@@ -0,0 +1,56 @@
+<?hh // strict
+/**
+ * @copyright   2010-2015, The Titon Project
+ * @license     http://opensource.org/licenses/bsd-license.php
+ * @link        http://titon.io
+ */
+
+namespace Titon\Cache;
+
+/**
+ * Interface for the strategies that convert cached values to and from strings.
+ * Every serializer has a unique flag, which is recorded with each item, so that items written
+ * with different serializers can be read by the same storage. Flags must be between 1 and 31.
+ *
+ * @package Titon\Cache
+ */
+interface Serializer {
+
+    const int PHP = 1;
+    const int IGBINARY = 2;
+    const int JSON = 3;
+    const int RAW = 4;
+    const int COMPRESSED = 128;
+
+    /**
+     * Return the flag that is recorded with each item.
+     *
+     * @return int
+     */
+    public function getFlag(): int;
+
+    /**
+     * Return true if the value can be serialized without losing its type.
+     *
+     * @param mixed $value
+     * @return bool
+     */
+    public function isSupported(mixed $value): bool;
+
+    /**
+     * Convert a value into a string.
+     *
+     * @param mixed $value
+     * @return string
+     */
+    public function serialize(mixed $value): string;
+
+    /**
+     * Convert a string back into a value.
+     *
+     * @param string $data
+     * @return mixed
+     */
+    public function unserialize(string $data): mixed;
+
+}
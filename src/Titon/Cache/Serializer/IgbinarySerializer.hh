@@ -0,0 +1,73 @@
+<?hh // strict
+/**
+ * @copyright   2010-2015, The Titon Project
+ * @license     http://opensource.org/licenses/bsd-license.php
+ * @link        http://titon.io
+ */
+
+namespace Titon\Cache\Serializer;
+
+use Titon\Cache\Serializer;
+use Titon\Common\Exception\MissingExtensionException;
+
+/**
+ * A serializer that uses the igbinary extension, which is faster and more compact than the native serialize().
+ * Supports all serializable values.
+ *
+ * @link http://pecl.php.net/package/igbinary
+ *
+ * @package Titon\Cache\Serializer
+ */
+class IgbinarySerializer implements Serializer {
+
+    /**
+     * Validate that igbinary is installed.
+     *
+     * @throws \Titon\Common\Exception\MissingExtensionException
+     */
+    public function __construct() {
+        if (!static::isAvailable()) {
+            throw new MissingExtensionException('igbinary extension is not loaded');
+        }
+    }
+
+    /**
+     * Return true if the igbinary extension is installed.
+     *
+     * @return bool
+     */
+    public static function isAvailable(): bool {
+        return extension_loaded('igbinary');
+    }
+
+    /**
+     * {@inheritdoc}
+     */
+    public function getFlag(): int {
+        return self::IGBINARY;
+    }
+
+    /**
+     * {@inheritdoc}
+     */
+    public function isSupported(mixed $value): bool {
+        return true;
+    }
+
+    /**
+     * {@inheritdoc}
+     */
+    public function serialize(mixed $value): string {
+        // UNSAFE
+        return igbinary_serialize($value);
+    }
+
+    /**
+     * {@inheritdoc}
+     */
+    public function unserialize(string $data): mixed {
+        // UNSAFE
+        return igbinary_unserialize($data);
+    }
+
+}
@@ -0,0 +1,64 @@
+<?hh // strict
+/**
+ * @copyright   2010-2015, The Titon Project
+ * @license     http://opensource.org/licenses/bsd-license.php
+ * @link        http://titon.io
+ */
+
+namespace Titon\Cache\Serializer;
+
+use Titon\Cache\Serializer;
+
+/**
+ * A serializer that encodes values as JSON, which can be read by other languages.
+ * Only scalars, nulls, and arrays of them are supported, as objects would be decoded into arrays.
+ * Strings must be valid UTF-8, otherwise they cannot be encoded.
+ *
+ * @package Titon\Cache\Serializer
+ */
+class JsonSerializer implements Serializer {
+
+    /**
+     * {@inheritdoc}
+     */
+    public function getFlag(): int {
+        return self::JSON;
+    }
+
+    /**
+     * {@inheritdoc}
+     */
+    public function isSupported(mixed $value): bool {
+        if (is_array($value)) {
+            foreach ($value as $key => $item) {
+                if (!$this->isSupported($key) || !$this->isSupported($item)) {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        if (is_string($value)) {
+            return (bool) preg_match('//u', $value);
+        }
+
+        // Floats without a fraction would be decoded as integers
+        return ($value === null || is_int($value) || is_bool($value));
+    }
+
+    /**
+     * {@inheritdoc}
+     */
+    public function serialize(mixed $value): string {
+        return json_encode($value);
+    }
+
+    /**
+     * {@inheritdoc}
+     */
+    public function unserialize(string $data): mixed {
+        return json_decode($data, true);
+    }
+
+}
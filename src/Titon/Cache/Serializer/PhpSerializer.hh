@@ -0,0 +1,47 @@
+<?hh // strict
+/**
+ * @copyright   2010-2015, The Titon Project
+ * @license     http://opensource.org/licenses/bsd-license.php
+ * @link        http://titon.io
+ */
+
+namespace Titon\Cache\Serializer;
+
+use Titon\Cache\Serializer;
+
+/**
+ * A serializer that uses the native serialize() and unserialize() functions. Supports all serializable values.
+ *
+ * @package Titon\Cache\Serializer
+ */
+class PhpSerializer implements Serializer {
+
+    /**
+     * {@inheritdoc}
+     */
+    public function getFlag(): int {
+        return self::PHP;
+    }
+
+    /**
+     * {@inheritdoc}
+     */
+    public function isSupported(mixed $value): bool {
+        return true;
+    }
+
+    /**
+     * {@inheritdoc}
+     */
+    public function serialize(mixed $value): string {
+        return serialize($value);
+    }
+
+    /**
+     * {@inheritdoc}
+     */
+    public function unserialize(string $data): mixed {
+        return unserialize($data);
+    }
+
+}
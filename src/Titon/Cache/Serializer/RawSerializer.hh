@@ -0,0 +1,48 @@
+<?hh // strict
+/**
+ * @copyright   2010-2015, The Titon Project
+ * @license     http://opensource.org/licenses/bsd-license.php
+ * @link        http://titon.io
+ */
+
+namespace Titon\Cache\Serializer;
+
+use Titon\Cache\Serializer;
+
+/**
+ * A serializer that stores strings as is, which skips serializing large strings like rendered templates.
+ * Only strings are supported.
+ *
+ * @package Titon\Cache\Serializer
+ */
+class RawSerializer implements Serializer {
+
+    /**
+     * {@inheritdoc}
+     */
+    public function getFlag(): int {
+        return self::RAW;
+    }
+
+    /**
+     * {@inheritdoc}
+     */
+    public function isSupported(mixed $value): bool {
+        return is_string($value);
+    }
+
+    /**
+     * {@inheritdoc}
+     */
+    public function serialize(mixed $value): string {
+        return (string) $value;
+    }
+
+    /**
+     * {@inheritdoc}
+     */
+    public function unserialize(string $data): mixed {
+        return $data;
+    }
+
+}
@@ -24,6 +24,19 @@ interface Storage {
     const string UPTIME = 'uptime';
     const string MEMORY_USAGE = 'memoryUsage';
     const string MEMORY_AVAILABLE = 'memoryAvailable';
+    const string EVICTIONS = 'evictions';
+    const string ITEMS = 'items';
+
+    /**
+     * Write data to the storage cache only if the key does not exist, and return true if it was written.
+     * Storages shared between processes should implement this atomically, as it is used for locking.
+     *
+     * @param string $key
+     * @param mixed $value
+     * @param int $expires
+     * @return bool
+     */
+    public function add(string $key, mixed $value, int $expires): bool;
 
     /**
      * Deletes all items in the pool.
@@ -78,7 +91,7 @@ interface Storage {
 
     /**
      * Return the raw value from the storage pool instead of returning an item.
-     * If the item does not exist, throw a MissingItemException.
+     * If the item does not exist, throw a MissingItemException. Use tryGet() when a miss is expected.
      *
      * @param string $key
      * @return mixed
@@ -130,6 +143,15 @@ interface Storage {
      */
     public function increment(string $key, int $step = 1, int $initial = 0): int;
 
+    /**
+     * Invalidate all items persisted with any of the tags, or with a tag nested below them.
+     * Items are not removed, instead the version of each tag is bumped, and items of an older version are misses.
+     *
+     * @param array<string> $tags
+     * @return $this
+     */
+    public function invalidateTags(array<string> $tags): this;
+
     /**
      * Remove the item if it exists and return true, else return false.
      *
@@ -181,8 +203,18 @@ interface Storage {
      * @param string $key
      * @param \Titon\Cache\CacheCallback $callback
      * @param mixed $expires
+     * @param array<string> $tags
      * @return mixed
      */
-    public function store(string $key, CacheCallback $callback, mixed $expires = null): mixed;
+    public function store(string $key, CacheCallback $callback, mixed $expires = null, array<string> $tags = []): mixed;
+
+    /**
+     * Return the item from the storage pool if it exists, else return null.
+     * Unlike get(), a miss must not throw an exception, as misses are frequent and throwing is costly.
+     *
+     * @param string $key
+     * @return \Titon\Cache\HitItem
+     */
+    public function tryGet(string $key): ?HitItem;
 
 }
\ No newline at end of file
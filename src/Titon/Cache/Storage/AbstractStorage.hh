@@ -8,22 +8,57 @@
 namespace Titon\Cache\Storage;
 
 use Titon\Cache\Exception\MissingItemException;
+use Titon\Cache\Exception\UnsupportedOperationException;
 use Titon\Cache\CacheCallback;
 use Titon\Cache\HitItem;
 use Titon\Cache\Item;
 use Titon\Cache\ItemList;
 use Titon\Cache\ItemMap;
 use Titon\Cache\MissItem;
+use Titon\Cache\Serializer;
+use Titon\Cache\Serializer\IgbinarySerializer;
+use Titon\Cache\Serializer\JsonSerializer;
+use Titon\Cache\Serializer\PhpSerializer;
+use Titon\Cache\Serializer\RawSerializer;
 use Titon\Cache\StatsMap;
 use Titon\Cache\Storage;
+use Titon\Cache\TaggedValue;
+
+type StampedeMeta = shape('expires' => int, 'delta' => float);
+type StampedeOptions = shape('lock' => int, 'grace' => int, 'beta' => float, 'wait' => int);
 
 /**
  * Primary class for all storage engines to extend. Provides functionality for the Storage interface.
  *
+ * Storage engines implement _fetch(), and optionally _fetchItems(), which return items as they are persisted,
+ * and _remove(), which removes a single persisted item.
+ * Items that were persisted with tags are resolved here, by comparing the tag versions they were written with
+ * against the current versions, which are stored as regular items. Invalidating a tag only bumps its version,
+ * so it is a constant time operation regardless of how many items are tagged.
+ *
  * @package Titon\Cache\Storage
  */
 abstract class AbstractStorage implements Storage {
 
+    const string LOCK_SUFFIX = ':lock';
+    const string META_SUFFIX = ':meta';
+    const int POLL_INTERVAL = 50000;
+    const string VERSION_PREFIX = 'titon.version.';
+
+    /**
+     * The zlib compression level.
+     *
+     * @var int
+     */
+    protected int $_compressLevel = 6;
+
+    /**
+     * Serialized values of this many bytes or more are compressed, or 0 to disable compression.
+     *
+     * @var int
+     */
+    protected int $_compressThreshold = 0;
+
     /**
      * List of cache items to be committed.
      *
@@ -31,6 +66,40 @@ abstract class AbstractStorage implements Storage {
      */
     protected ItemList $_deferred = Vector {};
 
+    /**
+     * The serializer used for writing values.
+     *
+     * @var \Titon\Cache\Serializer
+     */
+    protected ?Serializer $_serializer;
+
+    /**
+     * Serializers used for reading values, keyed by their flag.
+     *
+     * @var Map<int, \Titon\Cache\Serializer>
+     */
+    protected Map<int, Serializer> $_serializers = Map {};
+
+    /**
+     * Stampede protection options for store(), or null if disabled.
+     *
+     * @var \Titon\Cache\Storage\StampedeOptions
+     */
+    protected ?StampedeOptions $_stampede;
+
+    /**
+     * {@inheritdoc}
+     *
+     * This check-then-write is not atomic, so storages shared between processes should use a native add.
+     */
+    public function add(string $key, mixed $value, int $expires): bool {
+        if ($this->has($key)) {
+            return false;
+        }
+
+        return $this->set($key, $value, $expires);
+    }
+
     /**
      * {@inheritdoc}
      */
@@ -42,8 +111,10 @@ abstract class AbstractStorage implements Storage {
      * {@inheritdoc}
      */
     public function commit(): bool {
-        foreach ($this->getDeferred() as $item) {
-            $this->save($item);
+        foreach ($this->getDeferredByExpiration() as $expires => $values) {
+            foreach ($values as $key => $value) {
+                $this->set($key, $value, $expires);
+            }
         }
 
         $this->getDeferred()->clear();
@@ -86,6 +157,67 @@ abstract class AbstractStorage implements Storage {
         return $this;
     }
 
+    /**
+     * Disable stampede protection for store().
+     *
+     * @return $this
+     */
+    public function disableStampedeProtection(): this {
+        $this->_stampede = null;
+
+        return $this;
+    }
+
+    /**
+     * Enable stampede protection for store(), so that when a stored item expires, it is recomputed by a single process.
+     *
+     *  - Only the process that acquires a lock, which is held for at most `$lock` seconds, recomputes the item.
+     *  - The item is kept for `$grace` seconds after it expires, and the stale value is returned
+     *    to other processes while it is being recomputed.
+     *  - The item may be recomputed before it expires, with a probability that grows as the expiration nears
+     *    and with how long the item took to compute. A higher `$beta` favors earlier recomputes, while 0 disables it.
+     *
+     * When there is no value to return, other processes wait for the lock holder, for at most `$wait` seconds,
+     * which is capped by `$lock`. If the lock is still held after that, the value is computed without being persisted,
+     * so that waiting processes do not all write it at once.
+     *
+     * As items are persisted until the end of the grace window, reads outside of store(), like get(), getItem()
+     * and has(), will return an expired item for up to `$grace` seconds. Use store() to read protected items.
+     *
+     * @param int $lock
+     * @param int $grace
+     * @param float $beta
+     * @param int $wait
+     * @return $this
+     */
+    public function enableStampedeProtection(int $lock = 30, int $grace = 60, float $beta = 1.0, int $wait = 1): this {
+        $lock = max(1, $lock);
+
+        $this->_stampede = shape(
+            'lock' => $lock,
+            'grace' => max(0, $grace),
+            'beta' => max(0.0, $beta),
+            'wait' => min($lock, max(0, $wait))
+        );
+
+        return $this;
+    }
+
+    /**
+     * {@inheritdoc}
+     *
+     * @throws \Titon\Cache\Exception\MissingItemException
+     */
+    public function get(string $key): mixed {
+        $item = $this->tryGet($key);
+
+        if ($item === null) {
+            throw new MissingItemException(sprintf('Item with key %s does not exist', $key));
+        }
+
+        return $item->get();
+    }
+
     /**
      * Return a list of items waiting to be cached.
      *
@@ -95,28 +227,114 @@ abstract class AbstractStorage implements Storage {
         return $this->_deferred;
     }
 
+    /**
+     * Return the values of the deferred items grouped by their expiration timestamp, so that backends
+     * with native batch writes can persist them in a single call per expiration.
+     * Items that have already expired are skipped, as they are in save().
+     * The versions of the tags of all items are read in a single batch.
+     *
+     * @return Map<int, Map<string, mixed>>
+     */
+    public function getDeferredByExpiration(): Map<int, Map<string, mixed>> {
+        $groups = Map {};
+        $items = Vector {};
+        $tags = [];
+        $time = time();
+
+        foreach ($this->getDeferred() as $item) {
+            if (($item->getExpiration()?->getTimestamp() ?: 0) > $time) {
+                $items[] = $item;
+                $tags = array_merge($tags, $item->getTags());
+            }
+        }
+
+        $versions = $this->_readTagVersions($tags);
+
+        foreach ($items as $item) {
+            $timestamp = $item->getExpiration()?->getTimestamp() ?: 0;
+
+            if (!$groups->contains($timestamp)) {
+                $groups[$timestamp] = Map {};
+            }
+
+            $groups[$timestamp][$item->getKey()] = $this->_tagValue($item->get(), $this->_selectTagVersions($item->getTags(), $versions));
+        }
+
+        return $groups;
+    }
+
     /**
      * {@inheritdoc}
      */
     public function getItem(string $key): Item {
-        try {
-            return new HitItem($key, $this->get($key));
-        } catch (MissingItemException $e) {
-            return new MissItem($key);
-        }
+        return $this->tryGet($key) ?: new MissItem($key);
     }
 
     /**
      * {@inheritdoc}
      */
     public function getItems(array<string> $keys = []): ItemMap {
-        $map = Map {};
+        return $this->_resolveItems($this->_fetchItems($keys));
+    }
 
-        foreach ($keys as $key) {
-            $map[$key] = $this->getItem($key);
+    /**
+     * Return the size in bytes from which serialized values are compressed, or 0 if compression is disabled.
+     *
+     * @return int
+     */
+    public function getCompressionThreshold(): int {
+        return $this->_compressThreshold;
+    }
+
+    /**
+     * Return the serializer used for writing values, which defaults to the PHP serializer.
+     *
+     * @return \Titon\Cache\Serializer
+     */
+    public function getSerializer(): Serializer {
+        if ($this->_serializer === null) {
+            $this->_serializer = new PhpSerializer();
         }
 
-        return $map;
+        return $this->_serializer;
+    }
+
+    /**
+     * Return the stampede protection options, or null if disabled.
+     *
+     * @return \Titon\Cache\Storage\StampedeOptions
+     */
+    public function getStampedeProtection(): ?StampedeOptions {
+        return $this->_stampede;
+    }
+
+    /**
+     * Return the current version of each tag, or 0 for tags that have never been written or invalidated.
+     *
+     * @param array<string> $tags
+     * @return Map<string, int>
+     */
+    public function getTagVersions(array<string> $tags): Map<string, int> {
+        $items = $this->_fetchItems(array_map($tag ==> self::VERSION_PREFIX . $tag, $tags));
+        $versions = Map {};
+
+        foreach ($tags as $tag) {
+            $item = $items[self::VERSION_PREFIX . $tag];
+
+            $versions[$tag] = $item->isHit() ? (int) $item->get() : 0;
+        }
+
+        return $versions;
+    }
+
+    /**
+     * {@inheritdoc}
+     *
+     * The value is fetched so that its tags can be validated, which is slower for large values than a native
+     * existence check. Use tryGet() instead of has() followed by get() to avoid fetching the value twice.
+     */
+    public function has(string $key): bool {
+        return ($this->tryGet($key) !== null);
     }
 
     /**
@@ -134,6 +352,32 @@ abstract class AbstractStorage implements Storage {
         return $value;
     }
 
+    /**
+     * {@inheritdoc}
+     */
+    public function invalidateTags(array<string> $tags): this {
+        $time = strtotime('+1 year');
+
+        foreach ($this->getTagVersions(array_values(array_unique($tags))) as $tag => $version) {
+            $this->set(self::VERSION_PREFIX . $tag, $this->_nextVersion($version), $time);
+        }
+
+        return $this;
+    }
+
+    /**
+     * {@inheritdoc}
+     *
+     * The meta of an item stored with stampede protection is removed as well.
+     */
+    public function remove(string $key): bool {
+        if ($this->_stampede !== null) {
+            $this->_remove($key . self::META_SUFFIX);
+        }
+
+        return $this->_remove($key);
+    }
+
     /**
      * {@inheritdoc}
      */
@@ -144,7 +388,7 @@ abstract class AbstractStorage implements Storage {
             return $this; // Already expired
         }
 
-        $this->set($item->getKey(), $item->get(), $timestamp);
+        $this->set($item->getKey(), $this->_tagValue($item->get(), $this->_readTagVersions($item->getTags())), $timestamp);
 
         return $this;
     }
@@ -158,6 +402,35 @@ abstract class AbstractStorage implements Storage {
         return $this;
     }
 
+    /**
+     * Compress serialized values of a minimum size in bytes with zlib. A threshold of 0 disables compression.
+     * Engines that do not serialize values themselves, like APC, Memcache and Memory, ignore this setting.
+     *
+     * @param int $threshold
+     * @param int $level
+     * @return $this
+     */
+    public function setCompression(int $threshold, int $level = 6): this {
+        $this->_compressThreshold = max(0, $threshold);
+        $this->_compressLevel = min(9, max(1, $level));
+
+        return $this;
+    }
+
+    /**
+     * Set the serializer used for writing values. Values written with other serializers can still be read.
+     * Engines that do not serialize values themselves, like APC, Memcache and Memory, ignore this setting.
+     *
+     * @param \Titon\Cache\Serializer $serializer
+     * @return $this
+     */
+    public function setSerializer(Serializer $serializer): this {
+        $this->_serializer = $serializer;
+        $this->_serializers[$serializer->getFlag()] = $serializer;
+
+        return $this;
+    }
+
     /**
      * {@inheritdoc}
      */
@@ -167,17 +440,477 @@ abstract class AbstractStorage implements Storage {
 
     /**
      * {@inheritdoc}
+     *
+     * Tag versions are read before the callback is called, so that tags invalidated while the value
+     * is being computed also invalidate the stored value.
      */
-    public function store(string $key, CacheCallback $callback, mixed $expires = null): mixed {
-        if ($this->has($key)) {
-            return $this->getItem($key)->get();
+    public function store(string $key, CacheCallback $callback, mixed $expires = null, array<string> $tags = []): mixed {
+        if ($this->_stampede !== null) {
+            return $this->_storeProtected($key, $callback, $expires, $tags, $this->_stampede);
+        }
+
+        $item = $this->tryGet($key);
+
+        if ($item !== null) {
+            return $item->get();
         }
 
+        $versions = $this->_readTagVersions($tags);
         $value = call_user_func($callback);
+        $timestamp = (new Item($key, $value, $expires))->getExpiration()?->getTimestamp() ?: 0;
 
-        $this->save(new Item($key, $value, $expires));
+        if ($timestamp > time()) {
+            $this->set($key, $this->_tagValue($value, $versions), $timestamp);
+        }
 
         return $value;
     }
 
+    /**
+     * {@inheritdoc}
+     *
+     * Items persisted with tags are only returned if none of their tags have been invalidated since.
+     */
+    public function tryGet(string $key): ?HitItem {
+        $item = $this->_fetch($key);
+
+        if ($item === null) {
+            return null;
+        }
+
+        $value = $item->get();
+
+        if ($value instanceof TaggedValue) {
+            return $this->_untag($key, $value, $this->getTagVersions($value->getTags()));
+        }
+
+        return $item;
+    }
+
+    /**
+     * Expand tags into all of their dot namespaces, so that `user.5.views` becomes `user`, `user.5`, and `user.5.views`.
+     *
+     * @param array<string> $tags
+     * @return array<string>
+     */
+    protected function _expandTags(array<string> $tags): array<string> {
+        $expanded = [];
+
+        foreach ($tags as $tag) {
+            $namespace = '';
+
+            foreach (explode('.', $tag) as $part) {
+                $namespace .= ($namespace === '' ? '' : '.') . $part;
+                $expanded[] = $namespace;
+            }
+        }
+
+        return array_values(array_unique($expanded));
+    }
+
+    /**
+     * Return an item as it is persisted, or null if it does not exist or has expired.
+     *
+     * @param string $key
+     * @return \Titon\Cache\HitItem
+     */
+    abstract protected function _fetch(string $key): ?HitItem;
+
+    /**
+     * Return multiple items as they are persisted. Storage engines with native batch reads should override this.
+     *
+     * @param array<string> $keys
+     * @return \Titon\Cache\ItemMap
+     */
+    protected function _fetchItems(array<string> $keys): ItemMap {
+        $map = Map {};
+
+        foreach ($keys as $key) {
+            $map[$key] = $this->_fetch($key) ?: new MissItem($key);
+        }
+
+        return $map;
+    }
+
+    /**
+     * Return the serializer for a flag, or throw an exception if there is none.
+     *
+     * @param int $flag
+     * @return \Titon\Cache\Serializer
+     * @throws \Titon\Cache\Exception\UnsupportedOperationException
+     */
+    protected function _getSerializerByFlag(int $flag): Serializer {
+        if ($this->_serializers->contains($flag)) {
+            return $this->_serializers[$flag];
+        }
+
+        $serializer = null;
+
+        switch ($flag) {
+            case Serializer::PHP:
+                $serializer = new PhpSerializer();
+                break;
+            case Serializer::IGBINARY:
+                if (IgbinarySerializer::isAvailable()) {
+                    $serializer = new IgbinarySerializer();
+                }
+                break;
+            case Serializer::JSON:
+                $serializer = new JsonSerializer();
+                break;
+            case Serializer::RAW:
+                $serializer = new RawSerializer();
+                break;
+        }
+
+        if ($serializer === null) {
+            throw new UnsupportedOperationException(sprintf('No serializer available for flag %s', $flag));
+        }
+
+        return $this->_serializers[$flag] = $serializer;
+    }
+
+    /**
+     * Acquire a lock that is held until released, or for at most a number of seconds.
+     * Return a random token that identifies the owner of the lock, or null if the lock is held by another process.
+     *
+     * @param string $key
+     * @param int $ttl
+     * @return string
+     */
+    protected function _lock(string $key, int $ttl): ?string {
+        $token = uniqid('', true) . mt_rand();
+
+        return $this->add($key, $token, time() + $ttl) ? $token : null;
+    }
+
+    /**
+     * Return the version that follows the current version of a tag. Versions are based on the current time in microseconds,
+     * so a version that is evicted and written again never repeats a previous version.
+     *
+     * @param int $version
+     * @return int
+     */
+    protected function _nextVersion(int $version): int {
+        return max($version + 1, (int) (microtime(true) * 1000000));
+    }
+
+    /**
+     * Return the current versions of the tags, including the namespaces of each tag.
+     * Tags that have no version yet are given one, so that an evicted version invalidates the item instead of reviving it.
+     *
+     * @param array<string> $tags
+     * @return Map<string, int>
+     */
+    protected function _readTagVersions(array<string> $tags): Map<string, int> {
+        if (!$tags) {
+            return Map {};
+        }
+
+        $tags = $this->_expandTags($tags);
+        $versions = $this->getTagVersions($tags);
+        $time = strtotime('+1 year');
+
+        foreach ($tags as $tag) {
+            if ($versions[$tag] === 0) {
+                $version = $this->_nextVersion(0);
+
+                // Another process may have written the version in between
+                if (!$this->add(self::VERSION_PREFIX . $tag, $version, $time)) {
+                    $version = $this->getTagVersions([$tag])[$tag];
+                }
+
+                $versions[$tag] = $version;
+            }
+        }
+
+        return $versions;
+    }
+
+    /**
+     * Compute the value of an item, and persist it with its meta while the lock is held.
+     * Without a lock token, the value is only computed, as another process is persisting it.
+     * Tag versions are read before computing, so that tags invalidated in the meantime invalidate the value.
+     *
+     * @param string $key
+     * @param \Titon\Cache\CacheCallback $callback
+     * @param mixed $expires
+     * @param array<string> $tags
+     * @param \Titon\Cache\Storage\StampedeOptions $options
+     * @param string $token
+     * @return mixed
+     */
+    protected function _recompute(string $key, CacheCallback $callback, mixed $expires, array<string> $tags, StampedeOptions $options, ?string $token): mixed {
+        $start = microtime(true);
+
+        // The lock is held until the value and meta are written, so that waiting processes read the new value
+        try {
+            $versions = $this->_readTagVersions($tags);
+            $value = call_user_func($callback);
+            $timestamp = (new Item($key, $value, $expires))->getExpiration()?->getTimestamp() ?: 0;
+
+            if ($token !== null && $timestamp > time()) {
+                $meta = shape(
+                    'expires' => $timestamp,
+                    'delta' => microtime(true) - $start
+                );
+
+                // Kept beyond the expiration so the stale value can be served while recomputing
+                $this->set($key, $this->_tagValue($value, $versions), $timestamp + $options['grace']);
+                $this->set($key . self::META_SUFFIX, $meta, $timestamp + $options['grace']);
+            }
+        } finally {
+            if ($token !== null) {
+                $this->_unlock($key . self::LOCK_SUFFIX, $token);
+            }
+        }
+
+        return $value;
+    }
+
+    /**
+     * Remove a single item as it is persisted.
+     *
+     * @param string $key
+     * @return bool
+     */
+    abstract protected function _remove(string $key): bool;
+
+    /**
+     * Unwrap tagged values in a map of persisted items, or turn them into misses if any of their tags were invalidated.
+     * The current versions of all tags are read in a single batch.
+     *
+     * @param \Titon\Cache\ItemMap $items
+     * @return \Titon\Cache\ItemMap
+     */
+    protected function _resolveItems(ItemMap $items): ItemMap {
+        $tags = [];
+
+        foreach ($items as $item) {
+            $value = $item->get();
+
+            if ($item->isHit() && $value instanceof TaggedValue) {
+                $tags = array_merge($tags, $value->getTags());
+            }
+        }
+
+        if (!$tags) {
+            return $items;
+        }
+
+        $versions = $this->getTagVersions(array_values(array_unique($tags)));
+        $map = Map {};
+
+        foreach ($items as $key => $item) {
+            $value = $item->get();
+
+            if ($item->isHit() && $value instanceof TaggedValue) {
+                $item = $this->_untag($key, $value, $versions) ?: new MissItem($key);
+            }
+
+            $map[$key] = $item;
+        }
+
+        return $map;
+    }
+
+    /**
+     * Return the versions of the tags, including the namespaces of each tag, from a batch read with _readTagVersions().
+     *
+     * @param array<string> $tags
+     * @param Map<string, int> $versions
+     * @return Map<string, int>
+     */
+    protected function _selectTagVersions(array<string> $tags, Map<string, int> $versions): Map<string, int> {
+        $selected = Map {};
+
+        foreach ($this->_expandTags($tags) as $tag) {
+            $selected[$tag] = $versions[$tag];
+        }
+
+        return $selected;
+    }
+
+    /**
+     * Serialize a value with the current serializer, and compress it if it is above the threshold.
+     * The serializer and compression are recorded in a leading flag byte, so that the value can be read
+     * regardless of the settings at that time. Strings are always stored raw, as they need no serializing,
+     * and values not supported by the current serializer fall back to the PHP serializer.
+     *
+     * @param mixed $value
+     * @return string
+     */
+    protected function _serialize(mixed $value): string {
+        $serializer = $this->getSerializer();
+
+        if (is_string($value)) {
+            $serializer = $this->_getSerializerByFlag(Serializer::RAW);
+
+        } else if (!$serializer->isSupported($value)) {
+            $serializer = $this->_getSerializerByFlag(Serializer::PHP);
+        }
+
+        $flag = $serializer->getFlag();
+        $data = $serializer->serialize($value);
+
+        if ($this->_compressThreshold && strlen($data) >= $this->_compressThreshold) {
+            $compressed = gzcompress($data, $this->_compressLevel);
+
+            if ($compressed !== false && strlen($compressed) < strlen($data)) {
+                $data = $compressed;
+                $flag |= Serializer::COMPRESSED;
+            }
+        }
+
+        return chr($flag) . $data;
+    }
+
+    /**
+     * Return true if an item should be recomputed, either because it has expired and is within the grace window,
+     * or because it was picked for an early recompute.
+     *
+     * @param \Titon\Cache\Storage\StampedeMeta $meta
+     * @param float $beta
+     * @return bool
+     */
+    protected function _shouldRecompute(StampedeMeta $meta, float $beta): bool {
+        $time = microtime(true);
+
+        if ($time >= $meta['expires']) {
+            return true;
+        }
+
+        if ($beta <= 0) {
+            return false;
+        }
+
+        $random = mt_rand(1, mt_getrandmax()) / mt_getrandmax();
+
+        return ($time - ($meta['delta'] * $beta * log($random)) >= $meta['expires']);
+    }
+
+    /**
+     * Read and write cache using a callback, while protecting against concurrent recomputes.
+     *
+     * @param string $key
+     * @param \Titon\Cache\CacheCallback $callback
+     * @param mixed $expires
+     * @param array<string> $tags
+     * @param \Titon\Cache\Storage\StampedeOptions $options
+     * @return mixed
+     */
+    protected function _storeProtected(string $key, CacheCallback $callback, mixed $expires, array<string> $tags, StampedeOptions $options): mixed {
+        $metaKey = $key . self::META_SUFFIX;
+        $lockKey = $key . self::LOCK_SUFFIX;
+        $until = microtime(true) + $options['wait'];
+
+        do {
+            $items = $this->getItems([$key, $metaKey]);
+            $item = $items[$key];
+
+            if ($item->isHit()) {
+                $meta = $items[$metaKey]->get();
+
+                if (!is_array($meta) || !$this->_shouldRecompute(shape(
+                    'expires' => (int) $meta['expires'],
+                    'delta' => (float) $meta['delta']
+                ), $options['beta'])) {
+                    return $item->get();
+                }
+
+                // Serve the current value while another process recomputes
+                $token = $this->_lock($lockKey, $options['lock']);
+
+                if ($token === null) {
+                    return $item->get();
+                }
+
+                return $this->_recompute($key, $callback, $expires, $tags, $options, $token);
+            }
+
+            $token = $this->_lock($lockKey, $options['lock']);
+
+            if ($token !== null) {
+                return $this->_recompute($key, $callback, $expires, $tags, $options, $token);
+            }
+
+            usleep(self::POLL_INTERVAL);
+        } while (microtime(true) < $until);
+
+        // The lock holder did not finish in time, so try once more, else compute without persisting
+        return $this->_recompute($key, $callback, $expires, $tags, $options, $this->_lock($lockKey, $options['lock']));
+    }
+
+    /**
+     * Wrap a value with the versions of its tags, as returned by _readTagVersions().
+     *
+     * @param mixed $value
+     * @param Map<string, int> $versions
+     * @return mixed
+     */
+    protected function _tagValue(mixed $value, Map<string, int> $versions): mixed {
+        if ($versions->isEmpty()) {
+            return $value;
+        }
+
+        return new TaggedValue($value, $versions);
+    }
+
+    /**
+     * Unserialize a value that was serialized with _serialize(). Values that were written with a plain serialize(),
+     * before the flag byte was introduced, are unserialized as is.
+     *
+     * @param string $payload
+     * @return mixed
+     */
+    protected function _unserialize(string $payload): mixed {
+        if ($payload === '') {
+            return '';
+        }
+
+        $flag = ord($payload[0]);
+        $id = $flag & ~Serializer::COMPRESSED;
+
+        if ($id < Serializer::PHP || $id > 31) {
+            return unserialize($payload); // Legacy
+        }
+
+        $data = (string) substr($payload, 1);
+
+        if ($flag & Serializer::COMPRESSED) {
+            $data = (string) gzuncompress($data);
+        }
+
+        return $this->_getSerializerByFlag($id)->unserialize($data);
+    }
+
+    /**
+     * Release a lock acquired with _lock(), but only if it is still owned by the token,
+     * as the lock may have expired and been acquired by another process.
+     *
+     * @param string $key
+     * @param string $token
+     */
+    protected function _unlock(string $key, string $token): void {
+        if ($this->_fetch($key)?->get() === $token) {
+            $this->_remove($key);
+        }
+    }
+
+    /**
+     * Return a hit item with the unwrapped value if all versions of a tagged value are current, else return null.
+     *
+     * @param string $key
+     * @param \Titon\Cache\TaggedValue $value
+     * @param Map<string, int> $versions
+     * @return \Titon\Cache\HitItem
+     */
+    protected function _untag(string $key, TaggedValue $value, Map<string, int> $versions): ?HitItem {
+        if (!$value->isCurrent($versions)) {
+            return null;
+        }
+
+        return new HitItem($key, $value->getValue());
+    }
+
 }
\ No newline at end of file
@@ -7,7 +7,9 @@
 
 namespace Titon\Cache\Storage;
 
-use Titon\Cache\Exception\MissingItemException;
+use Titon\Cache\HitItem;
+use Titon\Cache\ItemMap;
+use Titon\Cache\MissItem;
 use Titon\Cache\StatsMap;
 use Titon\Common\Exception\MissingExtensionException;
 
@@ -15,6 +17,8 @@ use Titon\Common\Exception\MissingExtensionException;
  * A storage engine that uses the APC extension for a cache store; requires pecl/apc.
  * This engine can be installed using the Cache::addStorage() method.
  *
+ * Values are serialized by APC itself, so setSerializer() and setCompression() have no effect on this engine.
+ *
  * @link http://pecl.php.net/package/apc
  *
  * @package Titon\Cache\Storage
@@ -35,36 +39,33 @@ class ApcStorage extends AbstractStorage {
     /**
      * {@inheritdoc}
      */
-    public function flush(): bool {
-        return (apc_clear_cache() && apc_clear_cache('user'));
+    public function add(string $key, mixed $value, int $expires): bool {
+        return apc_add($key, $value, $expires - time());
     }
 
     /**
-     * {@inheritdoc}
+     * Persist all deferred items by passing an array to `apc_store`, with a single call per distinct expiration.
+     *
+     * @return bool
      */
-    public function get(string $key): mixed {
+    public function commit(): bool {
         $success = true;
-        $value = apc_fetch($key, $success);
+        $time = time();
 
-        if ($value === false && $success === false) {
-            throw new MissingItemException(sprintf('Item with key %s does not exist', $key));
+        foreach ($this->getDeferredByExpiration() as $expires => $values) {
+            $success = !apc_store($values->toArray(), null, $expires - $time) && $success; // Returns the failed keys
         }
 
-        return $value;
-    }
+        $this->getDeferred()->clear();
 
-    /**
-     * {@inheritdoc}
-     */
-    public function has(string $key): bool {
-        return apc_exists($key);
+        return $success;
     }
 
     /**
      * {@inheritdoc}
      */
-    public function remove(string $key): bool {
-        return apc_delete($key);
+    public function flush(): bool {
+        return (apc_clear_cache() && apc_clear_cache('user'));
     }
 
     /**
@@ -98,4 +99,48 @@ class ApcStorage extends AbstractStorage {
         };
     }
 
+    /**
+     * {@inheritdoc}
+     */
+    protected function _fetch(string $key): ?HitItem {
+        $success = true;
+        $value = apc_fetch($key, $success);
+
+        if ($value === false && $success === false) {
+            return null;
+        }
+
+        return new HitItem($key, $value);
+    }
+
+    /**
+     * Return all items in a single call by passing an array to `apc_fetch`.
+     *
+     * @param array<string> $keys
+     * @return \Titon\Cache\ItemMap
+     */
+    protected function _fetchItems(array<string> $keys): ItemMap {
+        $map = Map {};
+
+        if (!$keys) {
+            return $map;
+        }
+
+        $success = true;
+        $values = apc_fetch($keys, $success) ?: [];
+
+        foreach ($keys as $key) {
+            $map[$key] = array_key_exists($key, $values) ? new HitItem($key, $values[$key]) : new MissItem($key);
+        }
+
+        return $map;
+    }
+
+    /**
+     * {@inheritdoc}
+     */
+    protected function _remove(string $key): bool {
+        return apc_delete($key);
+    }
+
 }
\ No newline at end of file
@@ -7,6 +7,7 @@
 
 namespace Titon\Cache\Storage;
 
+use Titon\Cache\HitItem;
 use Titon\Db\Query;
 use Titon\Db\Repository;
 use Titon\Db\RepositoryAware;
@@ -15,6 +16,9 @@ use Titon\Db\RepositoryAware;
  * A storage engine that uses a database table for storing data.
  * Requires the Titon DB package for executing queries.
  *
+ * Since values are stored in a text column, serialized payloads are base64 encoded,
+ * as the flag byte, binary serializers, and compressed data are not valid text.
+ *
  * @package Titon\Cache\Storage
  */
 class DatabaseStorage extends AbstractStorage {
@@ -49,14 +53,35 @@ class DatabaseStorage extends AbstractStorage {
     /**
      * {@inheritdoc}
      */
-    public function get(string $key): mixed {
+    public function set(string $key, mixed $value, mixed $expires = null): bool {
+        $repo = $this->getRepository();
+
+        if ($entity = $this->find($key)->first()) {
+            return (bool) $repo->update($entity->id, [
+                'value' => $this->_serialize($value)
+            ]);
+
+        } else {
+            return (bool) $repo->create([
+                'key' => $key,
+                'value' => $this->_serialize($value),
+                'expires_at' => $this->expires($expires)
+            ]);
+        }
+    }
+
+    /**
+     * {@inheritdoc}
+     */
+    protected function _fetch(string $key): ?HitItem {
         if ($entity = $this->find($key)->first()) {
             if ($entity->expires_at < date('Y-m-d H:i:s')) {
                 $this->getRepository()->delete($entity->id);
+
                 return null;
             }
 
-            return unserialize($entity->value);
+            return new HitItem($key, $this->_unserialize($entity->value));
         }
 
         return null;
@@ -65,35 +90,31 @@ class DatabaseStorage extends AbstractStorage {
     /**
      * {@inheritdoc}
      */
-    public function has(string $key): bool {
-        return (bool) $this->find($key)->count();
+    protected function _remove(string $key): bool {
+        return (bool) $this->getRepository()->query(Query::DELETE)->where('key', $key)->save();
     }
 
     /**
-     * {@inheritdoc}
+     * Base64 encode the serialized payload so that it can be stored in a text column.
+     *
+     * @param mixed $value
+     * @return string
      */
-    public function remove(string $key): bool {
-        return (bool) $this->getRepository()->query(Query::DELETE)->where('key', $key)->save();
+    protected function _serialize(mixed $value): string {
+        return base64_encode(parent::_serialize($value));
     }
 
     /**
-     * {@inheritdoc}
+     * Decode a base64 encoded payload. Values that were written with a plain serialize(), before payloads were encoded,
+     * are never valid base64, and are passed through as is.
+     *
+     * @param string $payload
+     * @return mixed
      */
-    public function set(string $key, mixed $value, mixed $expires = null): bool {
-        $repo = $this->getRepository();
+    protected function _unserialize(string $payload): mixed {
+        $decoded = base64_decode($payload, true);
 
-        if ($entity = $this->find($key)->first()) {
-            return (bool) $repo->update($entity->id, [
-                'value' => serialize($value)
-            ]);
-
-        } else {
-            return (bool) $repo->create([
-                'key' => $key,
-                'value' => serialize($value),
-                'expires_at' => $this->expires($expires)
-            ]);
-        }
+        return parent::_unserialize(($decoded === false) ? $payload : $decoded);
     }
 
 }
\ No newline at end of file
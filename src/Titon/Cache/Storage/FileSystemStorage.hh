@@ -7,13 +7,12 @@
 
 namespace Titon\Cache\Storage;
 
-use Titon\Cache\Exception\MissingItemException;
+use Titon\Cache\HitItem;
+use Titon\Cache\TaggedValue;
 use Titon\Io\Exception\InvalidPathException;
-use Titon\Io\File;
 use Titon\Io\Folder;
 
-type FileCache = shape('expires' => int, 'data' => string);
-type FileMap = Map<string, File>;
+type FileHeader = shape('expires' => int, 'size' => int, 'checksum' => int, 'tagged' => bool);
 
 /**
  * A storage engine that uses the servers local filesystem to store its cached items.
@@ -23,17 +22,23 @@ type FileMap = Map<string, File>;
  *        new FileSystemStorage('/path/to/cache/');
  * }}}
  *
+ * Every item is a file that starts with a fixed size binary header, which contains the expiration,
+ * the size of the serialized data, and its checksum. This allows existence checks to only read the header,
+ * while reads require a single read of the file. Files are written to a temporary file and renamed,
+ * or linked when added, so readers never see a partially written file, and are spread across hashed sub-directories.
+ * Expired files, and files with an invalid header that are older than a few seconds, are removed while
+ * holding a lock on the file, so that a process never removes a file that another process has just added.
+ * Items persisted with tags use a different magic, so that existence checks know to read and verify the tags.
+ *
  * @package Titon\Cache\Storage
  */
 class FileSystemStorage extends AbstractStorage {
 
-    /**
-     * List of cached file objects for the current request.
-     * Does not include files that already exist.
-     *
-     * @var \Titon\Cache\FileMap
-     */
-    protected FileMap $_files = Map {};
+    const string EXT = '.cache';
+    const int HEADER_SIZE = 16;
+    const int INVALID_AGE = 10;
+    const string MAGIC = 'TCF1';
+    const string TAGGED_MAGIC = 'TCT1';
 
     /**
      * Folder object for the cache folder.
@@ -55,11 +60,29 @@ class FileSystemStorage extends AbstractStorage {
         $this->_folder = new Folder($path, true);
     }
 
+    /**
+     * {@inheritdoc}
+     *
+     * The file is written to a temporary file and linked into place, which fails if the file exists,
+     * so only a single process can add a key, and the file is complete once it exists.
+     */
+    public function add(string $key, mixed $value, int $expires): bool {
+        if ($this->has($key)) {
+            return false;
+        }
+
+        $path = $this->_makePath($key);
+
+        // A file left with an invalid header would otherwise block the key forever
+        $this->_removeStale($path);
+
+        return $this->_addFile($path, $this->_encode($value, $expires));
+    }
+
     /**
      * {@inheritdoc}
      */
     public function flush(): bool {
-        $this->_files->clear();
         $this->_folder->flush();
 
         clearstatcache();
@@ -68,99 +91,293 @@ class FileSystemStorage extends AbstractStorage {
     }
 
     /**
-     * {@inheritdoc}
+     * Return the absolute path to the file of a cache key.
+     *
+     * @param string $key
+     * @return string
      */
-    public function get(string $key): mixed {
-        if ($this->has($key)) {
-            return unserialize($this->_readCache($key)['data']);
-        }
-
-        throw new MissingItemException(sprintf('Item with key %s does not exist', $key));
+    public function getPath(string $key): string {
+        return $this->_buildPath($key);
     }
 
     /**
      * {@inheritdoc}
      */
     public function has(string $key): bool {
-        if (file_exists($this->_buildPath($key))) {
-            if ($this->_readCache($key)['expires'] >= time()) {
-                return true;
-            } else {
-                $this->remove($key);
-            }
+        $header = $this->_readHeader($key);
+
+        if ($header === null) {
+            return false;
+        }
+
+        if ($header['tagged']) {
+            return parent::has($key);
         }
 
-        return false;
+        return true;
     }
 
     /**
      * {@inheritdoc}
      */
-    public function remove(string $key): bool {
-        $this->_loadCache($key)->delete();
-        $this->_files->remove($key);
+    public function set(string $key, mixed $value, int $expires): bool {
+        $path = $this->_makePath($key);
+        $temp = $path . '.' . uniqid('', true) . '.tmp';
+
+        if (file_put_contents($temp, $this->_encode($value, $expires)) === false) {
+            return false;
+        }
+
+        if (!@rename($temp, $path)) {
+            @unlink($temp);
+
+            return false;
+        }
 
         return true;
     }
 
     /**
-     * {@inheritdoc}
+     * Create a file with the contents, only if it does not exist. The contents are written to a temporary file
+     * that is hard linked into place. Stream wrappers do not support links, so the file is created exclusively
+     * and written instead.
+     *
+     * @param string $path
+     * @param string $contents
+     * @return bool
      */
-    public function set(string $key, mixed $value, int $expires): bool {
-        return $this->_loadCache($key)->write($expires . "\n" . serialize($value));
+    protected function _addFile(string $path, string $contents): bool {
+        if (strpos($path, '://') !== false) {
+            $handle = @fopen($path, 'x');
+
+            if (!$handle) {
+                return false;
+            }
+
+            $written = fwrite($handle, $contents);
+
+            fclose($handle);
+
+            return ($written !== false);
+        }
+
+        $temp = $path . '.' . uniqid('', true) . '.tmp';
+
+        if (file_put_contents($temp, $contents) === false) {
+            return false;
+        }
+
+        $added = @link($temp, $path);
+
+        @unlink($temp);
+
+        return $added;
     }
 
     /**
      * Build an absolute path to the cache on the file system using the defined key.
+     * The key is hashed, and the first 2 pairs of the hash are used as sub-directories.
      *
      * @param string $key
      * @return string
      */
-    <<__Memoize>>
     protected function _buildPath(string $key): string {
-        $path = trim(preg_replace('/[^a-z0-9\-]+/is', '-', $key), '-');
-        $path = $this->_folder->path() . $path . '.cache';
+        $hash = md5($key);
 
-        return $path;
+        return $this->_folder->path() . substr($hash, 0, 2) . '/' . substr($hash, 2, 2) . '/' . $hash . self::EXT;
     }
 
     /**
-     * Attempt to load a cache from the file system. If the cache does not exist, create it.
+     * Unpack the header from the start of the file contents, or return null if it is not a valid header.
+     *
+     * @param string $contents
+     * @return \Titon\Cache\Storage\FileHeader
+     */
+    protected function _decodeHeader(string $contents): ?FileHeader {
+        if (strlen($contents) < self::HEADER_SIZE) {
+            return null;
+        }
+
+        $header = unpack('a4magic/Nexpires/Nsize/Nchecksum', substr($contents, 0, self::HEADER_SIZE));
+
+        if (!$header || !in_array($header['magic'], [self::MAGIC, self::TAGGED_MAGIC], true)) {
+            return null;
+        }
+
+        return shape(
+            'expires' => (int) $header['expires'],
+            'size' => (int) $header['size'],
+            'checksum' => (int) $header['checksum'],
+            'tagged' => ($header['magic'] === self::TAGGED_MAGIC)
+        );
+    }
+
+    /**
+     * Serialize the value and prepend the header.
+     *
+     * @param mixed $value
+     * @param int $expires
+     * @return string
+     */
+    protected function _encode(mixed $value, int $expires): string {
+        $data = $this->_serialize($value);
+        $magic = ($value instanceof TaggedValue) ? self::TAGGED_MAGIC : self::MAGIC;
+
+        return pack('a4NNN', $magic, $expires, strlen($data), crc32($data)) . $data;
+    }
+
+    /**
+     * {@inheritdoc}
+     */
+    protected function _fetch(string $key): ?HitItem {
+        $path = $this->_buildPath($key);
+
+        if (!file_exists($path)) {
+            return null;
+        }
+
+        $contents = @file_get_contents($path);
+
+        if ($contents === false) {
+            return null;
+        }
+
+        $header = $this->_decodeHeader($contents);
+
+        if ($header === null) {
+            return null;
+        }
+
+        if ($this->_isExpired($header)) {
+            $this->_removeStale($path);
+
+            return null;
+        }
+
+        $data = (string) substr($contents, self::HEADER_SIZE);
+
+        // A file that is still being added, or is corrupt, is a miss
+        if (strlen($data) !== $header['size'] || crc32($data) !== $header['checksum']) {
+            return null;
+        }
+
+        return new HitItem($key, $this->_unserialize($data));
+    }
+
+    /**
+     * Return true if the file has expired.
+     *
+     * @param \Titon\Cache\Storage\FileHeader $header
+     * @return bool
+     */
+    protected function _isExpired(FileHeader $header): bool {
+        return ($header['expires'] < time());
+    }
+
+    /**
+     * Return the path to the file of a cache key, and create its sub-directories if they do not exist.
      *
      * @param string $key
-     * @return \Titon\Io\File
+     * @return string
      */
-    protected function _loadCache(string $key): File {
-        if ($this->_files->contains($key)) {
-            return $this->_files[$key];
+    protected function _makePath(string $key): string {
+        $path = $this->_buildPath($key);
+        $dir = dirname($path);
+
+        if (!is_dir($dir)) {
+            @mkdir($dir, 0755, true);
         }
 
-        return $this->_files[$key] = new File($this->_buildPath($key), true);
+        return $path;
     }
 
     /**
-     * Load the cached file and return the expires timestamp and serialized data.
+     * Read only the header of a file, or return null if the file does not exist or is invalid.
+     * Expired files are removed.
      *
      * @param string $key
-     * @return \Titon\Cache\Storage\FileCache
+     * @return \Titon\Cache\Storage\FileHeader
+     */
+    protected function _readHeader(string $key): ?FileHeader {
+        $path = $this->_buildPath($key);
+
+        if (!file_exists($path)) {
+            return null;
+        }
+
+        $handle = @fopen($path, 'rb');
+
+        if (!$handle) {
+            return null;
+        }
+
+        $header = $this->_decodeHeader((string) fread($handle, self::HEADER_SIZE));
+
+        fclose($handle);
+
+        if ($header === null) {
+            return null;
+        }
+
+        if ($this->_isExpired($header)) {
+            $this->_removeStale($path);
+
+            return null;
+        }
+
+        return $header;
+    }
+
+    /**
+     * {@inheritdoc}
      */
-    protected function _readCache(string $key): FileCache {
-        return $this->_splitCache($this->_loadCache($key)->read());
+    protected function _remove(string $key): bool {
+        $path = $this->_buildPath($key);
+
+        if (file_exists($path)) {
+            @unlink($path);
+        }
+
+        return true;
     }
 
     /**
-     * Split the cache into 2 separate parts, the expires timestamp, and the serialized data.
+     * Remove a file if it has expired, or if its header is invalid and it is older than `INVALID_AGE` seconds.
+     * The file is locked and checked again, and is only removed if it has not been replaced in between,
+     * so that two processes removing the same file never remove a file that was added since.
      *
-     * @param string $cache
-     * @return \Titon\Cache\Storage\FileCache
+     * @param string $path
+     * @return bool
      */
-    protected function _splitCache(string $cache): FileCache {
-        list($expires, $data) = explode("\n", $cache, 2);
+    protected function _removeStale(string $path): bool {
+        $handle = @fopen($path, 'rb');
 
-        return shape(
-            'expires' => (int) $expires,
-            'data' => $data
-        );
+        if (!$handle) {
+            return false;
+        }
+
+        $locked = flock($handle, LOCK_EX);
+        $header = $this->_decodeHeader((string) fread($handle, self::HEADER_SIZE));
+        $stat = fstat($handle);
+        $removed = false;
+
+        if ($header ? $this->_isExpired($header) : ($stat['mtime'] < time() - self::INVALID_AGE)) {
+            clearstatcache(true, $path);
+
+            $current = @stat($path);
+
+            if ($current && $current['ino'] === $stat['ino']) {
+                $removed = @unlink($path);
+            }
+        }
+
+        if ($locked) {
+            flock($handle, LOCK_UN);
+        }
+
+        fclose($handle);
+
+        return $removed;
     }
 
-}
\ No newline at end of file
+}
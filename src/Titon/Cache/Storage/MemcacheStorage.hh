@@ -7,7 +7,9 @@
 
 namespace Titon\Cache\Storage;
 
-use Titon\Cache\Exception\MissingItemException;
+use Titon\Cache\HitItem;
+use Titon\Cache\ItemMap;
+use Titon\Cache\MissItem;
 use Titon\Cache\StatsMap;
 use \Memcached;
 
@@ -15,6 +17,9 @@ use \Memcached;
  * A storage engine for the Memcache key-value store; requires pecl/memcached.
  * This engine can be installed using the Cache::addStorage() method.
  *
+ * Values are serialized and compressed by Memcached itself, through its `Memcached::OPT_SERIALIZER`
+ * and `Memcached::OPT_COMPRESSION` options, so setSerializer() and setCompression() have no effect on this engine.
+ *
  * {{{
  *        new MemcacheStorage(new Memcached());
  * }}}
@@ -44,47 +49,41 @@ class MemcacheStorage extends AbstractStorage {
     /**
      * {@inheritdoc}
      */
-    public function flush(): bool {
-        return $this->getMemcache()->flush();
+    public function add(string $key, mixed $value, int $expires): bool {
+        return $this->getMemcache()->add($key, $value, $expires);
     }
 
     /**
-     * {@inheritdoc}
+     * Persist all deferred items using `setMulti`, with a single round-trip per distinct expiration.
+     *
+     * @return bool
      */
-    public function get(string $key): mixed {
-        $value = $this->getMemcache()->get($key);
+    public function commit(): bool {
+        $success = true;
 
-        if ($value === false && $this->getMemcache()->getResultCode() === Memcached::RES_NOTFOUND) {
-            throw new MissingItemException(sprintf('Item with key %s does not exist', $key));
+        foreach ($this->getDeferredByExpiration() as $expires => $values) {
+            $success = $this->getMemcache()->setMulti($values->toArray(), $expires) && $success;
         }
 
-        return $value;
-    }
+        $this->getDeferred()->clear();
 
-    /**
-     * Return the Memcached instance.
-     *
-     * @return \Memcached
-     */
-    public function getMemcache(): Memcached {
-        return $this->_memcache;
+        return $success;
     }
 
     /**
      * {@inheritdoc}
      */
-    public function has(string $key): bool {
-        return (
-            $this->getMemcache()->get($key) &&
-            $this->getMemcache()->getResultCode() === Memcached::RES_SUCCESS
-        );
+    public function flush(): bool {
+        return $this->getMemcache()->flush();
     }
 
     /**
-     * {@inheritdoc}
+     * Return the Memcached instance.
+     *
+     * @return \Memcached
      */
-    public function remove(string $key): bool {
-        return $this->getMemcache()->delete($key);
+    public function getMemcache(): Memcached {
+        return $this->_memcache;
     }
 
     /**
@@ -111,4 +110,46 @@ class MemcacheStorage extends AbstractStorage {
         };
     }
 
+    /**
+     * {@inheritdoc}
+     */
+    protected function _fetch(string $key): ?HitItem {
+        $value = $this->getMemcache()->get($key);
+
+        if ($value === false && $this->getMemcache()->getResultCode() === Memcached::RES_NOTFOUND) {
+            return null;
+        }
+
+        return new HitItem($key, $value);
+    }
+
+    /**
+     * Return all items in a single round-trip using `getMulti`.
+     *
+     * @param array<string> $keys
+     * @return \Titon\Cache\ItemMap
+     */
+    protected function _fetchItems(array<string> $keys): ItemMap {
+        $map = Map {};
+
+        if (!$keys) {
+            return $map;
+        }
+
+        $values = $this->getMemcache()->getMulti($keys) ?: [];
+
+        foreach ($keys as $key) {
+            $map[$key] = array_key_exists($key, $values) ? new HitItem($key, $values[$key]) : new MissItem($key);
+        }
+
+        return $map;
+    }
+
+    /**
+     * {@inheritdoc}
+     */
+    protected function _remove(string $key): bool {
+        return $this->getMemcache()->delete($key);
+    }
+
 }
\ No newline at end of file
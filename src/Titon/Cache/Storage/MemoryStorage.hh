@@ -7,49 +7,193 @@
 
 namespace Titon\Cache\Storage;
 
-use Titon\Cache\Exception\MissingItemException;
-use Titon\Common\Cacheable;
+use Titon\Cache\HitItem;
+use Titon\Cache\StatsMap;
+use Titon\Cache\TaggedValue;
+
+type MemoryEntry = shape('value' => mixed, 'expires' => int, 'size' => int);
+type MemoryEntryMap = Map<string, MemoryEntry>;
 
 /**
- * A lightweight caching engine that stores data in memory for the duration of the HTTP request.
+ * A lightweight caching engine that stores data in memory for the duration of the process.
+ *
+ * Entries expire at their expiration timestamp, and the storage can be bound to a maximum number of entries
+ * and a maximum byte size, in which case the least recently used entries are evicted first. This allows
+ * the storage to be used in long running processes, like CLI workers, without growing indefinitely.
+ * Values are kept as is, so setSerializer() and setCompression() have no effect on this engine.
+ *
+ * {{{
+ *        new MemoryStorage(1000, 1048576); // 1000 entries, 1MB
+ * }}}
  *
  * @package Titon\Cache\Storage
  */
 class MemoryStorage extends AbstractStorage {
-    use Cacheable;
+
+    /**
+     * Cached entries, ordered from the least to the most recently used.
+     *
+     * @var \Titon\Cache\Storage\MemoryEntryMap
+     */
+    protected MemoryEntryMap $_entries = Map {};
+
+    /**
+     * Number of entries evicted to stay within the bounds.
+     *
+     * @var int
+     */
+    protected int $_evictions = 0;
+
+    /**
+     * Number of successful lookups.
+     *
+     * @var int
+     */
+    protected int $_hits = 0;
+
+    /**
+     * Maximum number of entries, or 0 for no limit.
+     *
+     * @var int
+     */
+    protected int $_maxItems = 0;
+
+    /**
+     * Maximum byte size of all entries, or 0 for no limit.
+     *
+     * @var int
+     */
+    protected int $_maxSize = 0;
+
+    /**
+     * Number of failed lookups, including expired entries.
+     *
+     * @var int
+     */
+    protected int $_misses = 0;
+
+    /**
+     * Byte size of all entries. Only tracked when a maximum size is set.
+     *
+     * @var int
+     */
+    protected int $_size = 0;
+
+    /**
+     * Timestamp of when the storage was created.
+     *
+     * @var int
+     */
+    protected int $_started = 0;
+
+    /**
+     * Set the bounds of the storage. A bound of 0 disables it.
+     * The byte size of a value is the length of its serialized form, so values must be serializable when bound by size.
+     *
+     * @param int $maxItems
+     * @param int $maxSize
+     */
+    public function __construct(int $maxItems = 0, int $maxSize = 0) {
+        $this->_maxItems = max(0, $maxItems);
+        $this->_maxSize = max(0, $maxSize);
+        $this->_started = time();
+    }
 
     /**
      * {@inheritdoc}
      */
     public function flush(): bool {
-        $this->flushCache();
+        $this->_entries->clear();
+        $this->_size = 0;
 
         return true;
     }
 
     /**
-     * {@inheritdoc}
+     * Return the maximum number of entries.
+     *
+     * @return int
      */
-    public function get(string $key): mixed {
-        if ($this->has($key)) {
-            return $this->getCache($key);
-        }
+    public function getMaxItems(): int {
+        return $this->_maxItems;
+    }
 
-        throw new MissingItemException(sprintf('Item with key %s does not exist', $key));
+    /**
+     * Return the maximum byte size of all entries.
+     *
+     * @return int
+     */
+    public function getMaxSize(): int {
+        return $this->_maxSize;
     }
 
     /**
      * {@inheritdoc}
      */
     public function has(string $key): bool {
-        return $this->hasCache($key);
+        $entry = $this->_entries->get($key);
+
+        if ($entry === null || $this->_isExpired($entry)) {
+            return false;
+        }
+
+        // Tagged entries must be checked against the current tag versions
+        if ($entry['value'] instanceof TaggedValue) {
+            return parent::has($key);
+        }
+
+        return true;
+    }
+
+    /**
+     * Remove all expired entries and return how many were removed.
+     *
+     * @return int
+     */
+    public function purge(): int {
+        $expired = [];
+
+        foreach ($this->_entries as $key => $entry) {
+            if ($this->_isExpired($entry)) {
+                $expired[] = $key;
+            }
+        }
+
+        foreach ($expired as $key) {
+            $this->_remove($key);
+        }
+
+        return count($expired);
     }
 
     /**
      * {@inheritdoc}
+     *
+     * An expiration of 0 stores the entry until it is evicted or removed.
+     * Return false if the value alone is larger than the maximum size, in which case the previous entry is removed,
+     * so that it is not served as stale.
      */
-    public function remove(string $key): bool {
-        $this->removeCache($key);
+    public function set(string $key, mixed $value, int $expires): bool {
+        $size = $this->_maxSize ? strlen($key) + strlen(serialize($value)) : 0;
+
+        if ($this->_maxSize && $size > $this->_maxSize) {
+            $this->_remove($key);
+
+            return false;
+        }
+
+        // Remove first so the entry is moved to the most recently used position
+        $this->_remove($key);
+
+        $this->_entries[$key] = shape(
+            'value' => $value,
+            'expires' => $expires,
+            'size' => $size
+        );
+
+        $this->_size += $size;
+
+        $this->_evict();
 
         return true;
     }
@@ -57,10 +201,89 @@ class MemoryStorage extends AbstractStorage {
     /**
      * {@inheritdoc}
      */
-    public function set(string $key, mixed $value, int $expires): bool {
-        $this->setCache($key, $value);
+    public function stats(): StatsMap {
+        return Map {
+            self::HITS => $this->_hits,
+            self::MISSES => $this->_misses,
+            self::EVICTIONS => $this->_evictions,
+            self::ITEMS => count($this->_entries),
+            self::UPTIME => $this->_started,
+            self::MEMORY_USAGE => $this->_size,
+            self::MEMORY_AVAILABLE => $this->_maxSize ? ($this->_maxSize - $this->_size) : false
+        };
+    }
+
+    /**
+     * Evict the least recently used entries until the storage is within its bounds.
+     */
+    protected function _evict(): void {
+        while (
+            ($this->_maxItems && count($this->_entries) > $this->_maxItems) ||
+            ($this->_maxSize && $this->_size > $this->_maxSize)
+        ) {
+            $key = $this->_entries->firstKey();
+
+            if ($key === null) {
+                break;
+            }
+
+            $this->_remove($key);
+            $this->_evictions++;
+        }
+    }
+
+    /**
+     * {@inheritdoc}
+     */
+    protected function _fetch(string $key): ?HitItem {
+        $entry = $this->_entries->get($key);
+
+        if ($entry === null) {
+            $this->_misses++;
+
+            return null;
+        }
+
+        if ($this->_isExpired($entry)) {
+            $this->_misses++;
+            $this->_remove($key);
+
+            return null;
+        }
+
+        $this->_hits++;
+
+        // Move to the most recently used position
+        if ($this->_entries->lastKey() !== $key) {
+            $this->_entries->remove($key);
+            $this->_entries[$key] = $entry;
+        }
+
+        return new HitItem($key, $entry['value']);
+    }
+
+    /**
+     * Return true if the entry has expired.
+     *
+     * @param \Titon\Cache\Storage\MemoryEntry $entry
+     * @return bool
+     */
+    protected function _isExpired(MemoryEntry $entry): bool {
+        return ($entry['expires'] > 0 && $entry['expires'] < time());
+    }
+
+    /**
+     * {@inheritdoc}
+     */
+    protected function _remove(string $key): bool {
+        $entry = $this->_entries->get($key);
+
+        if ($entry !== null) {
+            $this->_size -= $entry['size'];
+            $this->_entries->remove($key);
+        }
 
         return true;
     }
 
-}
\ No newline at end of file
+}
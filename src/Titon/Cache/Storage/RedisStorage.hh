@@ -7,7 +7,9 @@
 
 namespace Titon\Cache\Storage;
 
-use Titon\Cache\Exception\MissingItemException;
+use Titon\Cache\HitItem;
+use Titon\Cache\ItemMap;
+use Titon\Cache\MissItem;
 use Titon\Cache\StatsMap;
 use \Redis;
 
@@ -44,51 +46,58 @@ class RedisStorage extends AbstractStorage {
     /**
      * {@inheritdoc}
      */
-    public function flush(): bool {
-        return $this->getRedis()->flushDB();
+    public function add(string $key, mixed $value, int $expires): bool {
+        return (bool) $this->getRedis()->set($key, $this->_serialize($value), ['nx', 'ex' => $expires - time()]);
     }
 
     /**
-     * {@inheritdoc}
+     * Persist all deferred items in a single pipelined round-trip.
+     *
+     * @return bool
      */
-    public function get(string $key): mixed {
-        $value = $this->getRedis()->get($key);
+    public function commit(): bool {
+        $groups = $this->getDeferredByExpiration();
+        $success = true;
 
-        if ($value === false) {
-            throw new MissingItemException(sprintf('Item with key %s does not exist', $key));
+        if ($groups) {
+            $pipeline = $this->getRedis()->multi(Redis::PIPELINE);
+            $time = time();
+
+            foreach ($groups as $expires => $values) {
+                foreach ($values as $key => $value) {
+                    $pipeline->setex($key, $expires - $time, $this->_serialize($value));
+                }
+            }
+
+            $success = !in_array(false, (array) $pipeline->exec(), true);
         }
 
-        return unserialize($value);
-    }
+        $this->getDeferred()->clear();
 
-    /**
-     * Return the Redis instance.
-     *
-     * @return \Redis
-     */
-    public function getRedis(): Redis {
-        return $this->_redis;
+        return $success;
     }
 
     /**
      * {@inheritdoc}
      */
-    public function has(string $key): bool {
-        return $this->getRedis()->exists($key);
+    public function flush(): bool {
+        return $this->getRedis()->flushDB();
     }
 
     /**
-     * {@inheritdoc}
+     * Return the Redis instance.
+     *
+     * @return \Redis
      */
-    public function remove(string $key): bool {
-        return (bool) $this->getRedis()->delete($key);
+    public function getRedis(): Redis {
+        return $this->_redis;
     }
 
     /**
      * {@inheritdoc}
      */
     public function set(string $key, mixed $value, int $expires): bool {
-        return $this->getRedis()->setex($key, $expires - time(), serialize($value)); // Redis is TTL
+        return $this->getRedis()->setex($key, $expires - time(), $this->_serialize($value)); // Redis is TTL
     }
 
     /**
@@ -106,4 +115,60 @@ class RedisStorage extends AbstractStorage {
         };
     }
 
+    /**
+     * {@inheritdoc}
+     */
+    protected function _fetch(string $key): ?HitItem {
+        $value = $this->getRedis()->get($key);
+
+        if ($value === false) {
+            return null;
+        }
+
+        return new HitItem($key, $this->_unserialize($value));
+    }
+
+    /**
+     * Return all items in a single round-trip using `mget`.
+     *
+     * @param array<string> $keys
+     * @return \Titon\Cache\ItemMap
+     */
+    protected function _fetchItems(array<string> $keys): ItemMap {
+        $map = Map {};
+
+        if (!$keys) {
+            return $map;
+        }
+
+        $values = $this->getRedis()->mget($keys);
+
+        foreach (array_values($keys) as $i => $key) {
+            $value = array_key_exists($i, $values) ? $values[$i] : false;
+
+            $map[$key] = ($value === false) ? new MissItem($key) : new HitItem($key, $this->_unserialize($value));
+        }
+
+        return $map;
+    }
+
+    /**
+     * {@inheritdoc}
+     */
+    protected function _remove(string $key): bool {
+        return (bool) $this->getRedis()->delete($key);
+    }
+
+    /**
+     * Release the lock with a script, so that checking the owner and removing the lock is atomic.
+     *
+     * @param string $key
+     * @param string $token
+     */
+    protected function _unlock(string $key, string $token): void {
+        $script = "if redis.call('get', KEYS[1]) == ARGV[1] then return redis.call('del', KEYS[1]) end return 0";
+
+        $this->getRedis()->eval($script, [$key, $this->_serialize($token)], 1);
+    }
+
 }
\ No newline at end of file
@@ -0,0 +1,458 @@
+<?hh // strict
+/**
+ * @copyright   2010-2015, The Titon Project
+ * @license     http://opensource.org/licenses/bsd-license.php
+ * @link        http://titon.io
+ */
+
+namespace Titon\Cache\Storage;
+
+use Titon\Cache\HitItem;
+use Titon\Cache\ItemMap;
+use Titon\Cache\MissItem;
+use Titon\Cache\StatsMap;
+use Titon\Cache\Storage;
+
+type TieredEntry = shape('generation' => int, 'value' => mixed);
+
+/**
+ * A storage engine that places a fast in-process L1 storage, like MemoryStorage or ApcStorage,
+ * in front of a shared L2 storage, like RedisStorage, MemcacheStorage or FileSystemStorage.
+ *
+ * Reads are served from L1 when possible, else read through from L2 and kept in L1 for a short TTL.
+ * Writes go through to L2 first, then to L1. To keep the L1 of all processes coherent, a generation counter
+ * is stored in L2 and bumped whenever an item is removed or the storage is flushed. Every L1 entry records
+ * the generation it was written in, and entries of an older generation are treated as misses.
+ * The generation is read from L2 at most once per refresh interval, and writes by other processes
+ * are visible once the L1 TTL of an entry has passed.
+ *
+ * Bumping the generation re-reads it from L2, and claims the next generation with an atomic `add()`,
+ * so that concurrent invalidations never share a generation. Since a single generation covers all keys,
+ * every `remove()` also discards the L1 entries of all other keys in all processes. Workloads that remove
+ * keys often should prefer expiring items, or use a storage per key space.
+ *
+ * The same applies to `invalidateTags()`. Values read through from L2 are kept in L1 without their tags,
+ * so the L1 can not check their versions, and the generation is bumped on every tag invalidation.
+ * Unlike the single version bump of other storage engines, invalidating a tag therefore also discards
+ * the L1 of all processes, and the next read of every key goes to L2. Workloads that invalidate tags often
+ * should give tagged items a storage of their own, or use the L2 storage directly.
+ *
+ * {{{
+ *        new TieredStorage(new MemoryStorage(1000), new RedisStorage($redis), 5);
+ * }}}
+ *
+ * @package Titon\Cache\Storage
+ */
+class TieredStorage extends AbstractStorage {
+
+    const string GENERATION_KEY = 'titon.tiered.generation';
+    const string HIT_RATIO = 'hitRatio';
+    const string L1 = 'l1';
+    const string L2 = 'l2';
+
+    /**
+     * Hit and miss counters per tier.
+     *
+     * @var Map<string, Map<string, int>>
+     */
+    protected Map<string, Map<string, int>> $_counters = Map {
+        self::L1 => Map {self::HITS => 0, self::MISSES => 0},
+        self::L2 => Map {self::HITS => 0, self::MISSES => 0}
+    };
+
+    /**
+     * The current generation, as last read from L2.
+     *
+     * @var int
+     */
+    protected int $_generation = 0;
+
+    /**
+     * Timestamp of when the generation should be read from L2 again.
+     *
+     * @var int
+     */
+    protected int $_generationExpires = 0;
+
+    /**
+     * The in-process storage.
+     *
+     * @var \Titon\Cache\Storage
+     */
+    protected Storage $_l1;
+
+    /**
+     * Seconds an item is kept in L1.
+     *
+     * @var int
+     */
+    protected int $_l1Ttl = 5;
+
+    /**
+     * The shared storage.
+     *
+     * @var \Titon\Cache\Storage
+     */
+    protected Storage $_l2;
+
+    /**
+     * Seconds between reading the generation from L2.
+     *
+     * @var int
+     */
+    protected int $_refreshInterval = 1;
+
+    /**
+     * Set the tiers, the L1 TTL, and how often the generation is read from L2.
+     *
+     * @param \Titon\Cache\Storage $l1
+     * @param \Titon\Cache\Storage $l2
+     * @param int $l1Ttl
+     * @param int $refreshInterval
+     */
+    public function __construct(Storage $l1, Storage $l2, int $l1Ttl = 5, int $refreshInterval = 1) {
+        $this->_l1 = $l1;
+        $this->_l2 = $l2;
+        $this->_l1Ttl = max(1, $l1Ttl);
+        $this->_refreshInterval = max(0, $refreshInterval);
+    }
+
+    /**
+     * {@inheritdoc}
+     */
+    public function add(string $key, mixed $value, int $expires): bool {
+        if (!$this->getL2()->add($key, $value, $expires)) {
+            return false;
+        }
+
+        $this->_setL1($key, $value, $expires);
+
+        return true;
+    }
+
+    /**
+     * {@inheritdoc}
+     */
+    public function flush(): bool {
+        // Keep the latest generation, as flushing L2 removes it
+        $this->_generation = max($this->_readGeneration(), $this->_generation);
+
+        $this->getL1()->flush();
+        $flushed = $this->getL2()->flush();
+
+        $this->invalidate();
+
+        return $flushed;
+    }
+
+    /**
+     * Return the current generation, reading it from L2 if the refresh interval has passed.
+     *
+     * @return int
+     */
+    public function getGeneration(): int {
+        $time = time();
+
+        if ($time >= $this->_generationExpires) {
+            $this->_generation = $this->_readGeneration();
+            $this->_generationExpires = $time + $this->_refreshInterval;
+        }
+
+        return $this->_generation;
+    }
+
+    /**
+     * Return the in-process storage.
+     *
+     * @return \Titon\Cache\Storage
+     */
+    public function getL1(): Storage {
+        return $this->_l1;
+    }
+
+    /**
+     * Return the shared storage.
+     *
+     * @return \Titon\Cache\Storage
+     */
+    public function getL2(): Storage {
+        return $this->_l2;
+    }
+
+    /**
+     * Invalidate the L1 of all processes by bumping the generation. The generation is read from L2 instead of
+     * the process cache, and the next generation is claimed in L2 with an atomic add, so that two processes
+     * invalidating at once each end up with a generation that no L1 entry was written in.
+     *
+     * @return int
+     */
+    public function invalidate(): int {
+        $generation = max($this->_readGeneration(), $this->_generation);
+
+        // A claim only needs to outlive the L1 entries that could have been written in its generation
+        $expires = time() + $this->_l1Ttl + $this->_refreshInterval + 1;
+
+        do {
+            $generation++;
+        } while (!$this->getL2()->add(self::GENERATION_KEY . '.' . $generation, 1, $expires));
+
+        $this->_setGeneration($generation);
+
+        return $generation;
+    }
+
+    /**
+     * {@inheritdoc}
+     *
+     * The generation is also bumped, as values read through from L2 are kept in L1 without their tags.
+     * This discards the L1 entries of all keys in all processes, not only those of the tagged items.
+     */
+    public function invalidateTags(array<string> $tags): this {
+        parent::invalidateTags($tags);
+
+        $this->invalidate();
+
+        return $this;
+    }
+
+    /**
+     * {@inheritdoc}
+     *
+     * The generation is bumped so that no process reads the removed item from its L1,
+     * which also discards the L1 entries of all other keys.
+     */
+    public function remove(string $key): bool {
+        $removed = parent::remove($key);
+
+        $this->invalidate();
+
+        return $removed;
+    }
+
+    /**
+     * {@inheritdoc}
+     */
+    public function set(string $key, mixed $value, int $expires): bool {
+        if (!$this->getL2()->set($key, $value, $expires)) {
+            return false;
+        }
+
+        $this->_setL1($key, $value, $expires);
+
+        return true;
+    }
+
+    /**
+     * Return the hits, misses, and hit ratio per tier, as well as overall.
+     *
+     * @return \Titon\Cache\StatsMap
+     */
+    public function stats(): StatsMap {
+        $l1 = $this->_counters[self::L1];
+        $l2 = $this->_counters[self::L2];
+        $hits = $l1[self::HITS] + $l2[self::HITS];
+
+        return Map {
+            self::HITS => $hits,
+            self::MISSES => $l2[self::MISSES],
+            self::HIT_RATIO => $this->_ratio($hits, $l2[self::MISSES]),
+            self::L1 => Map {
+                self::HITS => $l1[self::HITS],
+                self::MISSES => $l1[self::MISSES],
+                self::HIT_RATIO => $this->_ratio($l1[self::HITS], $l1[self::MISSES])
+            },
+            self::L2 => Map {
+                self::HITS => $l2[self::HITS],
+                self::MISSES => $l2[self::MISSES],
+                self::HIT_RATIO => $this->_ratio($l2[self::HITS], $l2[self::MISSES])
+            }
+        };
+    }
+
+    /**
+     * Increment a counter of a tier.
+     *
+     * @param string $tier
+     * @param string $counter
+     */
+    protected function _count(string $tier, string $counter): void {
+        $this->_counters[$tier][$counter]++;
+    }
+
+    /**
+     * {@inheritdoc}
+     */
+    protected function _fetch(string $key): ?HitItem {
+        if ($item = $this->_tryGetL1($key)) {
+            return $item;
+        }
+
+        $item = $this->getL2()->tryGet($key);
+
+        if ($item === null) {
+            $this->_count(self::L2, self::MISSES);
+
+            return null;
+        }
+
+        $this->_count(self::L2, self::HITS);
+        $this->_setL1($key, $item->get(), 0);
+
+        return $item;
+    }
+
+    /**
+     * Return items from L1, and read the L1 misses from L2 in a single batch.
+     *
+     * @param array<string> $keys
+     * @return \Titon\Cache\ItemMap
+     */
+    protected function _fetchItems(array<string> $keys): ItemMap {
+        $map = Map {};
+        $missing = [];
+
+        foreach ($keys as $key) {
+            $item = $this->_tryGetL1($key);
+
+            if ($item) {
+                $map[$key] = $item;
+            } else {
+                $map[$key] = new MissItem($key);
+                $missing[] = $key;
+            }
+        }
+
+        if ($missing) {
+            foreach ($this->getL2()->getItems($missing) as $key => $item) {
+                if ($item->isHit()) {
+                    $this->_count(self::L2, self::HITS);
+                    $this->_setL1($key, $item->get(), 0);
+
+                    $map[$key] = new HitItem($key, $item->get());
+                } else {
+                    $this->_count(self::L2, self::MISSES);
+                }
+            }
+        }
+
+        return $map;
+    }
+
+    /**
+     * Acquire the lock in L2 only, so that it is shared between processes.
+     *
+     * @param string $key
+     * @param int $ttl
+     * @return string
+     */
+    protected function _lock(string $key, int $ttl): ?string {
+        $token = uniqid('', true) . mt_rand();
+
+        return $this->getL2()->add($key, $token, time() + $ttl) ? $token : null;
+    }
+
+    /**
+     * Return the ratio of hits to lookups, or 0 if there were no lookups.
+     *
+     * @param int $hits
+     * @param int $misses
+     * @return float
+     */
+    protected function _ratio(int $hits, int $misses): float {
+        $total = $hits + $misses;
+
+        return $total ? round($hits / $total, 4) : 0.0;
+    }
+
+    /**
+     * Read the current generation from L2, bypassing the process cache.
+     *
+     * @return int
+     */
+    protected function _readGeneration(): int {
+        $item = $this->getL2()->tryGet(self::GENERATION_KEY);
+
+        return $item ? (int) $item->get() : 0;
+    }
+
+    /**
+     * Remove an item from both tiers.
+     *
+     * @param string $key
+     * @return bool
+     */
+    protected function _remove(string $key): bool {
+        $this->getL1()->remove($key);
+
+        return $this->getL2()->remove($key);
+    }
+
+    /**
+     * Write the generation to L2, and use it in the current process.
+     *
+     * @param int $generation
+     */
+    protected function _setGeneration(int $generation): void {
+        $this->getL2()->set(self::GENERATION_KEY, $generation, strtotime('+1 year'));
+
+        $this->_generation = $generation;
+        $this->_generationExpires = time() + $this->_refreshInterval;
+    }
+
+    /**
+     * Write a value to L1 in the current generation. The entry expires after the L1 TTL,
+     * or at the expiration of the item if that is sooner.
+     *
+     * @param string $key
+     * @param mixed $value
+     * @param int $expires
+     */
+    protected function _setL1(string $key, mixed $value, int $expires): void {
+        $ttl = time() + $this->_l1Ttl;
+
+        $this->getL1()->set($key, shape(
+            'generation' => $this->getGeneration(),
+            'value' => $value
+        ), $expires ? min($expires, $ttl) : $ttl);
+    }
+
+    /**
+     * Return an item from L1 if it exists and was written in the current generation, else return null.
+     *
+     * @param string $key
+     * @return \Titon\Cache\HitItem
+     */
+    protected function _tryGetL1(string $key): ?HitItem {
+        $item = $this->getL1()->tryGet($key);
+
+        if ($item !== null) {
+            $entry = $item->get();
+
+            if (is_array($entry) && array_key_exists('generation', $entry) && $entry['generation'] === $this->getGeneration()) {
+                $this->_count(self::L1, self::HITS);
+
+                return new HitItem($key, $entry['value']);
+            }
+        }
+
+        $this->_count(self::L1, self::MISSES);
+
+        return null;
+    }
+
+    /**
+     * Release the lock in L2 without bumping the generation, as locks are never kept in L1.
+     * The lock is only released if it is still owned by the token.
+     *
+     * @param string $key
+     * @param string $token
+     */
+    protected function _unlock(string $key, string $token): void {
+        $l2 = $this->getL2();
+
+        if ($l2->tryGet($key)?->get() === $token) {
+            $l2->remove($key);
+        }
+    }
+
+}
@@ -0,0 +1,86 @@
+<?hh // strict
+/**
+ * @copyright   2010-2015, The Titon Project
+ * @license     http://opensource.org/licenses/bsd-license.php
+ * @link        http://titon.io
+ */
+
+namespace Titon\Cache;
+
+/**
+ * The TaggedValue wraps a value that is persisted with tags, along with the version of every tag
+ * at the time it was written. When read, the value is only returned if all versions are still current.
+ *
+ * @package Titon\Cache
+ */
+class TaggedValue {
+
+    /**
+     * The wrapped value.
+     *
+     * @var mixed
+     */
+    protected mixed $_value;
+
+    /**
+     * Tag versions at the time the value was written.
+     *
+     * @var array<string, int>
+     */
+    protected array<string, int> $_versions = [];
+
+    /**
+     * Set the value and tag versions.
+     *
+     * @param mixed $value
+     * @param Map<string, int> $versions
+     */
+    public function __construct(mixed $value, Map<string, int> $versions) {
+        $this->_value = $value;
+        $this->_versions = $versions->toArray();
+    }
+
+    /**
+     * Return the wrapped value.
+     *
+     * @return mixed
+     */
+    public function getValue(): mixed {
+        return $this->_value;
+    }
+
+    /**
+     * Return the tags the value was written with.
+     *
+     * @return array<string>
+     */
+    public function getTags(): array<string> {
+        return array_keys($this->_versions);
+    }
+
+    /**
+     * Return the tag versions at the time the value was written.
+     *
+     * @return Map<string, int>
+     */
+    public function getVersions(): Map<string, int> {
+        return new Map($this->_versions);
+    }
+
+    /**
+     * Return true if every recorded version matches the current versions.
+     *
+     * @param Map<string, int> $current
+     * @return bool
+     */
+    public function isCurrent(Map<string, int> $current): bool {
+        foreach ($this->_versions as $tag => $version) {
+            if ($current->get($tag) !== $version) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+}
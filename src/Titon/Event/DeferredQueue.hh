@@ -0,0 +1,224 @@
+<?hh // strict
+/**
+ * @copyright   2010-2015, The Titon Project
+ * @license     http://opensource.org/licenses/bsd-license.php
+ * @link        http://titon.io
+ */
+
+namespace Titon\Event;
+
+use Psr\Log\LoggerInterface;
+use Titon\Common\FactoryAware;
+use \Exception;
+
+type DeferredEvent = shape('emitter' => Emitter, 'event' => string, 'params' => ParamList);
+type DeferredEventMap = Map<string, DeferredEvent>;
+
+/**
+ * The DeferredQueue holds events that should be emitted after the response has been sent to the client,
+ * so that non-critical observers, like auditing and analytics, are kept off the user facing latency.
+ *
+ * Events are dispatched in the order they were queued. An event can be coalesced, in which case
+ * a previously queued event with the same key on the same emitter is updated with the latest params
+ * instead of being queued again. Once the queue is full, newly queued events are dropped.
+ *
+ * A shared queue is available through `DeferredQueue::registry()`, which `Response::send()` dispatches.
+ * As the response has already been sent, exceptions thrown by observers are logged instead of thrown.
+ *
+ * @package Titon\Event
+ */
+class DeferredQueue {
+    use FactoryAware;
+
+    /**
+     * The maximum number of passes over the queue in a single dispatch.
+     */
+    const int MAX_PASSES = 10;
+
+    /**
+     * The maximum number of queued events.
+     *
+     * @var int
+     */
+    protected int $_capacity = 100;
+
+    /**
+     * The number of events dropped because the queue was full.
+     *
+     * @var int
+     */
+    protected int $_dropped = 0;
+
+    /**
+     * Logger for exceptions thrown by observers.
+     *
+     * @var \Psr\Log\LoggerInterface
+     */
+    protected ?LoggerInterface $_logger;
+
+    /**
+     * Queued events, in the order they will be dispatched.
+     *
+     * @var \Titon\Event\DeferredEventMap
+     */
+    protected DeferredEventMap $_queue = Map {};
+
+    /**
+     * Incrementing number used to key events that are not coalesced.
+     *
+     * @var int
+     */
+    protected int $_sequence = 0;
+
+    /**
+     * Set the maximum number of queued events.
+     *
+     * @param int $capacity
+     */
+    public function __construct(int $capacity = 100) {
+        $this->_capacity = max(1, $capacity);
+    }
+
+    /**
+     * Return the number of queued events.
+     *
+     * @return int
+     */
+    public function count(): int {
+        return count($this->_queue);
+    }
+
+    /**
+     * Emit all queued events in order, and return the emitted events.
+     * Events queued by observers during dispatching are emitted in a following pass of the same run,
+     * up to `MAX_PASSES`, so that observers that keep deferring events cannot loop forever.
+     * Events still queued after the last pass are kept for the next dispatch.
+     *
+     * An exception thrown by an observer is logged, and the remaining events are still emitted.
+     *
+     * @return Vector<Event>
+     */
+    public function dispatch(): Vector<Event> {
+        $events = Vector {};
+
+        for ($pass = 0; $this->_queue && $pass < self::MAX_PASSES; $pass++) {
+            $queue = $this->_queue;
+            $this->_queue = Map {};
+
+            foreach ($queue as $deferred) {
+                try {
+                    $events[] = $deferred['emitter']->emit($deferred['event'], $deferred['params']);
+
+                } catch (Exception $e) {
+                    $this->getLogger()?->error(sprintf('Deferred event %s failed: %s', $deferred['event'], $e->getMessage()), [
+                        'exception' => $e
+                    ]);
+                }
+            }
+        }
+
+        return $events;
+    }
+
+    /**
+     * Remove all queued events without dispatching them.
+     *
+     * @return $this
+     */
+    public function flush(): this {
+        $this->_queue->clear();
+        $this->_dropped = 0;
+
+        return $this;
+    }
+
+    /**
+     * Return the maximum number of queued events.
+     *
+     * @return int
+     */
+    public function getCapacity(): int {
+        return $this->_capacity;
+    }
+
+    /**
+     * Return the number of events dropped because the queue was full.
+     *
+     * @return int
+     */
+    public function getDropped(): int {
+        return $this->_dropped;
+    }
+
+    /**
+     * Return the logger for exceptions thrown by observers.
+     *
+     * @return \Psr\Log\LoggerInterface
+     */
+    public function getLogger(): ?LoggerInterface {
+        return $this->_logger;
+    }
+
+    /**
+     * Return the queued events, in the order they will be dispatched.
+     *
+     * @return \Titon\Event\DeferredEventMap
+     */
+    public function getQueue(): DeferredEventMap {
+        return $this->_queue;
+    }
+
+    /**
+     * Queue an event to be emitted through an emitter. If the event is coalesced and already queued for the emitter,
+     * the queued params are replaced while its position in the queue is kept.
+     * Return false if the event was dropped because the queue is full.
+     *
+     * @param \Titon\Event\Emitter $emitter
+     * @param string $event
+     * @param \Titon\Event\ParamList $params
+     * @param bool $coalesce
+     * @return bool
+     */
+    public function push(Emitter $emitter, string $event, ParamList $params, bool $coalesce = false): bool {
+        $deferred = shape(
+            'emitter' => $emitter,
+            'event' => $event,
+            'params' => $params
+        );
+
+        if ($coalesce) {
+            $key = spl_object_hash($emitter) . ':' . $event;
+
+            if ($this->_queue->contains($key)) {
+                $this->_queue[$key] = $deferred;
+
+                return true;
+            }
+        } else {
+            $key = '#' . $this->_sequence++;
+        }
+
+        if (count($this->_queue) >= $this->_capacity) {
+            $this->_dropped++;
+
+            return false;
+        }
+
+        $this->_queue[$key] = $deferred;
+
+        return true;
+    }
+
+    /**
+     * Set the logger for exceptions thrown by observers.
+     *
+     * @param \Psr\Log\LoggerInterface $logger
+     * @return $this
+     */
+    public function setLogger(LoggerInterface $logger): this {
+        $this->_logger = $logger;
+
+        return $this;
+    }
+
+}
\ No newline at end of file
@@ -31,6 +31,13 @@ trait Emittable {
         return $this->getEmitter()->emit($event, $params);
     }
 
+    /**
+     * @see \Titon\Event\Subject::emitDeferred()
+     */
+    public function emitDeferred(string $event, ParamList $params, bool $coalesce = false): bool {
+        return DeferredQueue::registry()->push($this->getEmitter(), $event, $params, $coalesce);
+    }
+
     /**
      * @see \Titon\Event\Emitter::emit()
      */
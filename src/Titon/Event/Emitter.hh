@@ -7,15 +7,22 @@
 
 namespace Titon\Event;
 
+type AsyncLimit = shape('concurrency' => int, 'timeout' => int, 'deadline' => int);
+type AsyncLimitMap = Map<string, AsyncLimit>;
 type EventMap = Map<string, Event>;
 type ObserverList = Vector<Observer>;
 type ObserverContainer = Map<string, ObserverList>;
 type ObserverCallback = (function(...): mixed);
+type ObserverPartition = shape('sync' => ObserverList, 'async' => ObserverList, 'once' => bool, 'stack' => CallStackList, 'keys' => Vector<string>);
+type ObserverPartitionMap = Map<string, ObserverPartition>;
 
 /**
  * The Emitter manages the registering and removing of observers (and listeners).
  * An emitted event will cycle through and trigger all observers.
  *
+ * Observers can also be registered on wildcard keys, like `view.rendered.*` or `view.**`,
+ * and will be triggered for every event key that the wildcard matches.
+ *
  * @package Titon\Event
  */
 class Emitter {
@@ -23,12 +30,62 @@ class Emitter {
     const int DEFAULT_PRIORITY = 100;
 
     /**
-     * Registered observers per event.
+     * How often, in microseconds, to check whether an async observer with a timeout has finished.
+     */
+    const int POLL_INTERVAL = 1000;
+
+    /**
+     * Async concurrency and timeout limits per event. The empty key holds the default for all events.
+     *
+     * @var \Titon\Event\AsyncLimitMap
+     */
+    protected AsyncLimitMap $_limits = Map {};
+
+    /**
+     * Index of concrete event keys, used to expand wildcards when emitting many events.
+     *
+     * @var \Titon\Event\EventIndex
+     */
+    protected EventIndex $_keys;
+
+    /**
+     * Registered observers per event, in order of priority.
      *
      * @var \Titon\Event\ObserverContainer
      */
     protected ObserverContainer $_observers = Map {};
 
+    /**
+     * Profiler to record the timing of every notified observer, across all emitters.
+     * Profiling is disabled when no profiler is set.
+     *
+     * @var \Titon\Event\Profiler
+     */
+    protected static ?Profiler $_profiler;
+
+    /**
+     * Cached sync and async observers, and the call stack, per event.
+     * An event partition is rebuilt after its observers have been modified.
+     *
+     * @var \Titon\Event\ObserverPartitionMap
+     */
+    protected ObserverPartitionMap $_partitions = Map {};
+
+    /**
+     * Index of wildcard event keys, used to find the wildcard observers for a concrete key.
+     *
+     * @var \Titon\Event\EventIndex
+     */
+    protected EventIndex $_wildcards;
+
+    /**
+     * Initialize the event key indexes.
+     */
+    public function __construct() {
+        $this->_keys = new EventIndex();
+        $this->_wildcards = new EventIndex();
+    }
+
     /**
      * Notify all synchronous and asynchronous observers, sorted by priority, about an event.
      * A list of parameters can be defined that will be passed to each observer.
@@ -39,34 +96,30 @@ class Emitter {
      */
     public function dispatch(Event $event, ParamList $params): Event {
         $key = $event->getKey();
+        $partition = $this->_getPartition($key);
 
         // Set call stack
-        $event->setCallStack($this->getCallStack($key));
+        $event->setCallStack($partition['stack']);
 
         // Add event as the 1st param
         array_unshift($params, $event);
 
-        // Group the observers
-        $observers = $this->getSortedObservers($key)->toVector(); // Clone so we can remove later
-        $syncObservers = Vector {};
-        $asyncObservers = Vector {};
+        // Notify observers
+        $this->_notifyObservers($partition['sync'], $event, $params);
 
-        foreach ($observers as $observer) {
-            if ($observer->isAsync()) {
-                $asyncObservers[] = $observer;
-            } else {
-                $syncObservers[] = $observer;
-            }
+        if ($partition['async']) {
+            $this->_notifyObserversAsync($partition['async'], $event, $params)->getWaitHandle()->join();
         }
 
-        // Notify observers
-        $this->_notifyObservers($syncObservers, $event, $params);
-        $this->_notifyObserversAsync($asyncObservers, $event, $params)->getWaitHandle()->join();
-
-        // Remove all `once` observers
-        foreach ($observers as $observer) {
-            if ($observer->isOnce() && $observer->hasExecuted()) {
-                $this->remove($key, $observer->getCallback());
+        // Remove all `once` observers, from the event key and any wildcard keys they came from
+        // The partition lists are never modified, only replaced, so they are safe to iterate while removing
+        if ($partition['once']) {
+            foreach ($partition['sync']->concat($partition['async']) as $observer) {
+                if ($observer->isOnce() && $observer->hasExecuted()) {
+                    foreach ($partition['keys'] as $observerKey) {
+                        $this->remove($observerKey, $observer->getCallback());
+                    }
+                }
             }
         }
 
@@ -75,6 +128,7 @@ class Emitter {
 
     /**
      * Emit a single event defined by an event name. Can pass an optional list of parameters.
+     * If the event has no observers, the event is returned without being dispatched.
      *
      * @uses Titon\Event\Event
      *
@@ -83,12 +137,16 @@ class Emitter {
      * @return \Titon\Event\Event
      */
     public function emit(string $event, ParamList $params): Event {
+        if (!$this->hasObservers($event)) {
+            return new Event($event);
+        }
+
         return $this->dispatch(new Event($event), $params);
     }
 
     /**
      * Emit multiple events at once by passing a list of event names, or event names separated by a space.
-     * If a `*` is provided in the key, a wildcard match will occur.
+     * If a `*` is provided in the key, all registered event keys that the wildcard matches will be emitted.
      *
      * @param mixed $event
      * @param \Titon\Event\ParamList $params
@@ -113,27 +171,48 @@ class Emitter {
     public function flush(string $event = ''): this {
         if (!$event) {
             $this->_observers->clear();
+            $this->_partitions->clear();
+            $this->_keys = new EventIndex();
+            $this->_wildcards = new EventIndex();
+
         } else {
             $this->_observers->remove($event);
+            $this->_invalidate($event);
+
+            if ($this->_isWildcard($event)) {
+                $this->_wildcards->remove($event);
+            } else {
+                $this->_keys->remove($event);
+            }
         }
 
         return $this;
     }
 
     /**
-     * Return the call stack (order of priority) for an event.
+     * Return the async limits for an event, or the default limits if the event has none.
      *
      * @param string $event
-     * @return \Titon\Event\CallStackList
+     * @return \Titon\Event\AsyncLimit
      */
-    public function getCallStack(string $event): CallStackList {
-        $stack = Vector {};
+    public function getAsyncLimit(string $event): AsyncLimit {
+        $limit = $this->_limits->get($event) ?: $this->_limits->get('');
 
-        foreach ($this->getSortedObservers($event) as $observer) {
-            $stack[] = $observer->getCaller();
+        if ($limit !== null) {
+            return $limit;
         }
 
-        return $stack;
+        return shape('concurrency' => 0, 'timeout' => 0, 'deadline' => 0);
+    }
+
+    /**
+     * Return the call stack (order of priority) for an event.
+     *
+     * @param string $event
+     * @return \Titon\Event\CallStackList
+     */
+    public function getCallStack(string $event): CallStackList {
+        return $this->_getPartition($event)['stack'];
     }
 
     /**
@@ -146,14 +225,17 @@ class Emitter {
     }
 
     /**
-     * Return all observers for an event.
+     * Return all observers registered on an event key, in order of priority.
+     * Observers of matching wildcard keys are not included.
      *
      * @param string $event
      * @return \Titon\Event\ObserverList
      */
     public function getObservers(string $event): ObserverList {
-        if ($this->hasObservers($event)) {
-            return $this->_observers[$event];
+        $observers = $this->_observers->get($event);
+
+        if ($observers !== null) {
+            return $observers;
         }
 
         return Vector {};
@@ -161,39 +243,49 @@ class Emitter {
 
     /**
      * Return all observers for an event sorted by priority.
+     * Observers are sorted when registered, so this is equivalent to `getObservers()`.
      *
      * @param string $event
      * @return \Titon\Event\ObserverList
      */
     public function getSortedObservers(string $event): ObserverList {
-        $observers = $this->getObservers($event);
-
-        if ($observers) {
-            usort($observers, (Observer $a, Observer $b) ==> {
-                if ($a->getPriority() == $b->getPriority()) {
-                    return 0;
-                }
-
-                return ($a->getPriority() < $b->getPriority()) ? -1 : 1;
-            });
-        }
+        return $this->getObservers($event);
+    }
 
-        return $observers;
+    /**
+     * Return the profiler used by all emitters.
+     *
+     * @return \Titon\Event\Profiler
+     */
+    public static function getProfiler(): ?Profiler {
+        return static::$_profiler;
     }
 
     /**
-     * Return true if the event has observers.
+     * Return true if the event has observers, either on the event key or on a wildcard key that matches it.
      *
      * @param string $event
      * @return bool
      */
     public function hasObservers(string $event): bool {
-        return $this->_observers->contains($event);
+        if ($this->_partitions->contains($event) || $this->getObservers($event)->count() > 0) {
+            return true;
+        }
+
+        if ($this->_wildcards->isEmpty()) {
+            return false;
+        }
+
+        return ($this->_getPartition($event)['stack']->count() > 0);
     }
 
     /**
      * Register a callback (observer) for an event.
      * A priority can be defined to change the order of execution.
+     * The observer is inserted after all observers with a lower or equal priority.
+     *
+     * If the event key contains a `*`, the observer will be triggered for every event that matches.
+     * A `*` segment matches a single segment, while a `**` segment matches one or more segments.
      *
      * @param string $event
      * @param \Titon\Event\ObserverCallback $callback
@@ -202,19 +294,48 @@ class Emitter {
      * @return $this
      */
     public function register(string $event, ObserverCallback $callback, int $priority = 0, bool $once = false): this {
-        if (!$this->hasObservers($event)) {
-            $this->_observers[$event] = Vector {};
-        }
-
         if (!$priority) {
-            $priority = count($this->_observers[$event]) + self::DEFAULT_PRIORITY;
+            $priority = count($this->getObservers($event)) + self::DEFAULT_PRIORITY;
         }
 
-        $this->_observers[$event][] = new Observer($callback, $priority, $once);
+        $this->_addObservers($event, Vector {new Observer($callback, $priority, $once)});
 
         return $this;
     }
 
+    /**
+     * Limit how async observers are notified for an event, or for all events if the event is empty.
+     * The concurrency is the maximum number of observers to run at once, the timeout is the maximum time in
+     * milliseconds a single observer may take, and the deadline is the maximum time in milliseconds for all
+     * async observers of the event. Observers that exceed a limit are marked as timed out on the event,
+     * and are no longer waited on, but still count against the concurrency until they finish, for at most
+     * another timeout, or until the deadline. A limit of 0 disables it.
+     *
+     * @param string $event
+     * @param int $concurrency
+     * @param int $timeout
+     * @param int $deadline
+     * @return $this
+     */
+    public function setAsyncLimit(string $event, int $concurrency, int $timeout = 0, int $deadline = 0): this {
+        $this->_limits[$event] = shape(
+            'concurrency' => max(0, $concurrency),
+            'timeout' => max(0, $timeout),
+            'deadline' => max(0, $deadline)
+        );
+
+        return $this;
+    }
+
+    /**
+     * Set the profiler used by all emitters, or disable profiling by passing null.
+     *
+     * @param \Titon\Event\Profiler $profiler
+     */
+    public static function setProfiler(?Profiler $profiler): void {
+        static::$_profiler = $profiler;
+    }
+
     /**
      * Register multiple events that are provided from a listener object.
      *
@@ -222,12 +343,37 @@ class Emitter {
      * @return $this
      */
     public function registerListener(Listener $listener): this {
-        foreach ($listener->registerEvents() as $event => $options) {
-            foreach ($this->_parseOptions($options) as $opt) {
-                // UNSAFE
-                // Since inst_meth() requires literal strings and we are passing variables
-                $this->register($event, inst_meth($listener, $opt['method']), $opt['priority'], $opt['once']);
+        return $this->registerWiring($listener, ListenerCompiler::getListenerWiring($listener));
+    }
+
+    /**
+     * Register the observers of an object in bulk, using wiring resolved by the listener compiler.
+     * Observers are grouped per event and merged into the sorted observer list at once,
+     * which results in the same order as registering them one at a time.
+     *
+     * @param mixed $object
+     * @param \Titon\Event\ListenerWiringList $wiring
+     * @return $this
+     */
+    public function registerWiring(mixed $object, ListenerWiringList $wiring): this {
+        $grouped = Map {};
+
+        foreach ($wiring as $wire) {
+            $event = $wire['event'];
+
+            if (!$grouped->contains($event)) {
+                $grouped[$event] = Vector {};
             }
+
+            $priority = $wire['priority'] ?: count($this->getObservers($event)) + count($grouped[$event]) + self::DEFAULT_PRIORITY;
+
+            // UNSAFE
+            // Since inst_meth() requires literal strings and we are passing variables
+            $grouped[$event][] = new Observer(inst_meth($object, $wire['method']), $priority, $wire['once'], $wire['async']);
+        }
+
+        foreach ($grouped as $event => $observers) {
+            $this->_addObservers($event, $observers);
         }
 
         return $this;
@@ -254,6 +400,10 @@ class Emitter {
             $this->_observers[$event]->removeKey($i);
         }
 
+        if ($indices) {
+            $this->_invalidate($event);
+        }
+
         return $this;
     }
 
@@ -264,17 +414,116 @@ class Emitter {
      * @return $this
      */
     public function removeListener(Listener $listener): this {
-        foreach ($listener->registerEvents() as $event => $options) {
-            foreach ($this->_parseOptions($options) as $opt) {
-                // UNSAFE
-                // Since inst_meth() requires literal strings and we are passing variables
-                $this->remove($event, inst_meth($listener, $opt['method']));
-            }
+        foreach (ListenerCompiler::getListenerWiring($listener) as $wire) {
+            // UNSAFE
+            // Since inst_meth() requires literal strings and we are passing variables
+            $this->remove($wire['event'], inst_meth($listener, $wire['method']));
         }
 
         return $this;
     }
 
+    /**
+     * Add observers to an event and keep the list sorted by priority.
+     * Added observers are placed after existing observers with an equal priority.
+     *
+     * @param string $event
+     * @param \Titon\Event\ObserverList $observers
+     */
+    protected function _addObservers(string $event, ObserverList $observers): void {
+        if (!$this->_observers->contains($event)) {
+            $this->_observers[$event] = Vector {};
+
+            if ($this->_isWildcard($event)) {
+                $this->_wildcards->add($event);
+            } else {
+                $this->_keys->add($event);
+            }
+        }
+
+        $existing = $this->_observers[$event];
+
+        // Sort the added observers while keeping the order of equal priorities
+        $sorted = [];
+
+        foreach ($observers as $observer) {
+            $index = count($sorted);
+
+            while ($index > 0 && $sorted[$index - 1]->getPriority() > $observer->getPriority()) {
+                $index--;
+            }
+
+            array_splice($sorted, $index, 0, [$observer]);
+        }
+
+        $sorted = new Vector($sorted);
+
+        // Append in place when the observers come after all existing observers, which is the common case
+        if (!$existing || $existing[count($existing) - 1]->getPriority() <= $sorted[0]->getPriority()) {
+            $existing->addAll($sorted);
+        } else {
+            $this->_observers[$event] = $this->_mergeObservers($existing, $sorted);
+        }
+
+        $this->_invalidate($event);
+    }
+
+    /**
+     * Return the cached partition of sync and async observers, and the call stack, for an event.
+     * Observers of matching wildcard keys are merged in by priority.
+     * The partition is built on first use after the event's observers have been modified.
+     *
+     * @param string $event
+     * @return \Titon\Event\ObserverPartition
+     */
+    protected function _getPartition(string $event): ObserverPartition {
+        $partition = $this->_partitions->get($event);
+
+        if ($partition !== null) {
+            return $partition;
+        }
+
+        $partition = shape(
+            'sync' => Vector {},
+            'async' => Vector {},
+            'once' => false,
+            'stack' => Vector {},
+            'keys' => Vector {$event}
+        );
+
+        $observers = $this->getObservers($event);
+
+        if (!$this->_wildcards->isEmpty()) {
+            foreach ($this->_wildcards->match($event) as $wildcard) {
+                if ($wildcard !== $event && $this->getObservers($wildcard)) {
+                    $observers = $this->_mergeObservers($observers, $this->getObservers($wildcard));
+                    $partition['keys'][] = $wildcard;
+                }
+            }
+        }
+
+        foreach ($observers as $observer) {
+            if ($observer->isAsync()) {
+                $partition['async'][] = $observer;
+            } else {
+                $partition['sync'][] = $observer;
+            }
+
+            if ($observer->isOnce()) {
+                $partition['once'] = true;
+            }
+
+            $partition['stack'][] = $observer->getCaller();
+        }
+
+        // Don't cache events without observers, as any key can be emitted
+        if ($partition['stack']) {
+            $this->_partitions[$event] = $partition;
+        }
+
+        return $partition;
+    }
+
     /**
      * Handle the response of an executed observer callback.
      * If the response is null, void (no return from callback), or true, don't do anything.
@@ -294,9 +543,67 @@ class Emitter {
         return true;
     }
 
+    /**
+     * Drop the cached partition for an event. Since wildcard keys affect many events, all partitions are dropped for them.
+     *
+     * @param string $event
+     */
+    protected function _invalidate(string $event): void {
+        if ($this->_isWildcard($event)) {
+            $this->_partitions->clear();
+        } else {
+            $this->_partitions->remove($event);
+        }
+    }
+
+    /**
+     * Return true if the event key contains a wildcard.
+     *
+     * @param string $event
+     * @return bool
+     */
+    protected function _isWildcard(string $event): bool {
+        return (strpos($event, '*') !== false);
+    }
+
+    /**
+     * Merge two lists of observers that are sorted by priority.
+     * Observers of the first list come first when priorities are equal.
+     *
+     * @param \Titon\Event\ObserverList $first
+     * @param \Titon\Event\ObserverList $second
+     * @return \Titon\Event\ObserverList
+     */
+    protected function _mergeObservers(ObserverList $first, ObserverList $second): ObserverList {
+        $merged = Vector {};
+        $i = 0;
+        $j = 0;
+        $firstCount = count($first);
+        $secondCount = count($second);
+
+        while ($i < $firstCount && $j < $secondCount) {
+            if ($second[$j]->getPriority() < $first[$i]->getPriority()) {
+                $merged[] = $second[$j++];
+            } else {
+                $merged[] = $first[$i++];
+            }
+        }
+
+        while ($i < $firstCount) {
+            $merged[] = $first[$i++];
+        }
+
+        while ($j < $secondCount) {
+            $merged[] = $second[$j++];
+        }
+
+        return $merged;
+    }
+
     /**
      * Notify the observer by executing the callback with the defined params.
      * Can optionally stop the event and set a state based on the callbacks response.
+     * If a profiler is set, the time and memory of the callback is recorded.
      *
      * @param \Titon\Event\Observer $observer
      * @param \Titon\Event\Event $event
@@ -308,27 +615,134 @@ class Emitter {
             return false;
         }
 
-        return $this->_handleResponse($event, $observer->execute($params));
+        $profiler = static::$_profiler;
+
+        if ($profiler === null) {
+            return $this->_handleResponse($event, $observer->execute($params));
+        }
+
+        $time = microtime(true);
+        $memory = memory_get_usage();
+        $response = $observer->execute($params);
+
+        $profiler->record($event->getKey(), $observer->getCaller(), microtime(true) - $time, memory_get_usage() - $memory);
+
+        return $this->_handleResponse($event, $response);
     }
 
     /**
-     * Asynchronously notify the observer.
+     * Asynchronously notify the observer. If an expiration time is defined and the observer has not finished by then,
+     * the observer is marked as timed out on the event and is no longer waited on. Its wait handle is added to
+     * the running list, if one is defined, as the observer keeps running in the background.
+     * If a profiler is set, the time and memory until the observer finished, or timed out, is recorded.
      *
      * @param \Titon\Event\Observer $observer
      * @param \Titon\Event\Event $event
      * @param \Titon\Event\ParamList $params
+     * @param float $expires
+     * @param Vector<WaitHandle<mixed>> $running
      * @return bool
      */
-    protected async function _notifyObserverAsync(Observer $observer, Event $event, ParamList $params): Awaitable<bool> {
+    protected async function _notifyObserverAsync(Observer $observer, Event $event, ParamList $params, float $expires = 0.0, ?Vector<WaitHandle<mixed>> $running = null): Awaitable<bool> {
         if ($event->isStopped()) {
             return false;
         }
 
-        $response = await $observer->asyncExecute($params);
+        $profiler = static::$_profiler;
+        $time = 0.0;
+        $memory = 0;
+
+        if ($profiler !== null) {
+            $time = microtime(true);
+            $memory = memory_get_usage();
+        }
+
+        if (!$expires) {
+            $response = await $observer->asyncExecute($params);
+
+        } else {
+            $handle = $observer->asyncExecute($params)->getWaitHandle();
+
+            while (!$handle->isFinished()) {
+                if (microtime(true) >= $expires) {
+                    $event->timeout($observer->getCaller());
+                    $running?->add($handle);
+                    $profiler?->record($event->getKey(), $observer->getCaller(), microtime(true) - $time, memory_get_usage() - $memory);
+
+                    return false;
+                }
+
+                await SleepWaitHandle::create(self::POLL_INTERVAL);
+            }
+
+            $response = $handle->result();
+        }
+
+        $profiler?->record($event->getKey(), $observer->getCaller(), microtime(true) - $time, memory_get_usage() - $memory);
 
         return $this->_handleResponse($event, $response);
     }
 
+    /**
+     * Notify async observers from a shared queue one at a time, until the queue is empty.
+     * Running multiple workers against the same queue bounds the number of observers that run at once.
+     * An observer that timed out keeps running in the background, so the worker waits for it to finish
+     * before starting the next observer, for at most another timeout, or until the deadline has passed.
+     * An observer that is still running after that no longer counts against the limit.
+     *
+     * @param \Titon\Event\ObserverList $queue
+     * @param \Titon\Event\Event $event
+     * @param \Titon\Event\ParamList $params
+     * @param int $timeout
+     * @param float $deadline
+     * @return Awaitable<bool>
+     */
+    protected async function _notifyObserverQueue(ObserverList $queue, Event $event, ParamList $params, int $timeout, float $deadline): Awaitable<bool> {
+        $running = Vector {};
+
+        while ($queue) {
+            $observer = $queue->pop();
+
+            if ($event->isStopped()) {
+                return false;
+            }
+
+            // A timed out observer still counts against the concurrency limit, but only for a bounded time
+            if ($running) {
+                $limit = $timeout ? microtime(true) + ($timeout / 1000) : $deadline;
+
+                if ($deadline) {
+                    $limit = min($limit, $deadline);
+                }
+
+                foreach ($running as $handle) {
+                    while (!$handle->isFinished() && microtime(true) < $limit) {
+                        await SleepWaitHandle::create(self::POLL_INTERVAL);
+                    }
+                }
+            }
+
+            $running->clear();
+
+            $expires = $timeout ? microtime(true) + ($timeout / 1000) : 0.0;
+
+            if ($deadline) {
+                // Observers that could not start before the deadline are timed out without running
+                if (microtime(true) >= $deadline) {
+                    $event->timeout($observer->getCaller());
+
+                    continue;
+                }
+
+                $expires = $expires ? min($expires, $deadline) : $deadline;
+            }
+
+            await $this->_notifyObserverAsync($observer, $event, $params, $expires, $running);
+        }
+
+        return true;
+    }
+
     /**
      * Loop over a list of observers and notify them for the defined event, with the defined params.
      *
@@ -351,6 +765,7 @@ class Emitter {
 
     /**
      * Loop over a list of async observers and execute them in parallel using an await handler.
+     * If the event has async limits, the observers are run by a bounded number of workers, each with a timeout.
      *
      * @param \Titon\Event\ObserverList $observers
      * @param \Titon\Event\Event $event
@@ -363,49 +778,29 @@ class Emitter {
         }
 
         $handles = Vector {};
+        $limit = $this->getAsyncLimit($event->getKey());
 
-        foreach ($observers as $observer) {
-            $handles[] = $this->_notifyObserverAsync($observer, $event, $params)->getWaitHandle();
-        }
-
-        await GenVectorWaitHandle::create($handles);
-
-        return true;
-    }
-
-    /**
-     * Parse the options from a listener into an indexed array of object method callbacks.
-     *
-     * @param array|string $options
-     * @return Vector<ListenerOption>
-     */
-    protected function _parseOptions(mixed $options): Vector<ListenerOption> {
-        if (!$options instanceof Vector) {
-            $options = new Vector([$options]);
-        }
-
-        invariant($options instanceof Vector, 'Event options must be a vector');
-
-        $parsed = Vector {};
+        if (!$limit['concurrency'] && !$limit['timeout'] && !$limit['deadline']) {
+            foreach ($observers as $observer) {
+                $handles[] = $this->_notifyObserverAsync($observer, $event, $params)->getWaitHandle();
+            }
 
-        foreach ($options as $option) {
-            $settings = shape(
-                'method' => '',
-                'priority' => 0,
-                'once' => false
-            );
+        } else {
+            $deadline = $limit['deadline'] ? microtime(true) + ($limit['deadline'] / 1000) : 0.0;
+            $workers = $limit['concurrency'] ? min($limit['concurrency'], count($observers)) : count($observers);
 
-            if (is_string($option)) {
-                $settings['method'] = $option;
+            // Reverse the queue so that observers are popped in order of priority
+            $queue = $observers->toVector();
+            $queue->reverse();
 
-            } else if ($option instanceof Map) {
-                $settings = array_merge($settings, $option->toArray());
+            for ($i = 0; $i < $workers; $i++) {
+                $handles[] = $this->_notifyObserverQueue($queue, $event, $params, $limit['timeout'], $deadline)->getWaitHandle();
             }
-
-            $parsed[] = $settings;
         }
 
-        return $parsed;
+        await GenVectorWaitHandle::create($handles);
+
+        return true;
     }
 
     /**
@@ -422,14 +817,8 @@ class Emitter {
         }
 
         foreach ($events as $event) {
-            if (strpos($event, '*') !== false) {
-                $pattern = '/^' . str_replace('*', '([-\w]+)', $event) . '$/i';
-
-                foreach ($this->_observers as $eventKey => $observers) {
-                    if (preg_match($pattern, $eventKey)) {
-                        $found[] = $eventKey;
-                    }
-                }
+            if ($this->_isWildcard($event)) {
+                $found->addAll($this->_keys->expand($event));
             } else {
                 $found[] = $event;
             }
@@ -16,6 +16,9 @@ type CallStackList = Vector<string>;
  * An object representing the current event being dispatched.
  * The event can be stopped at any time during the cycle.
  *
+ * Events are created for every emit, even when no observers are registered,
+ * so the data map and call stack are only allocated once they are used.
+ *
  * @package Titon\Event
  */
 class Event {
@@ -25,7 +28,7 @@ class Event {
      *
      * @var \Titon\Common\DataMap
      */
-    protected DataMap $_data = Map {};
+    protected ?DataMap $_data;
 
     /**
      * The event key.
@@ -53,7 +56,14 @@ class Event {
      *
      * @var \Titon\Event\CallStackList
      */
-    protected CallStackList $_stack = Vector {};
+    protected ?CallStackList $_stack;
+
+    /**
+     * Is the call stack shared with the emitter, and must be copied before it is returned?
+     *
+     * @var bool
+     */
+    protected bool $_stackShared = false;
 
     /**
      * The last state before the object was stopped.
@@ -70,6 +80,13 @@ class Event {
      */
     protected int $_time;
 
+    /**
+     * Callers of async observers that exceeded their timeout, or the event deadline.
+     *
+     * @var \Titon\Event\CallStackList
+     */
+    protected ?CallStackList $_timeouts;
+
     /**
      * Initialize the event.
      *
@@ -81,12 +98,25 @@ class Event {
     }
 
     /**
-     * Return the call stack in order of priority.
+     * Return the call stack in order of priority. A stack shared with the emitter is copied on the first call,
+     * so that dispatching does not allocate a copy for events whose stack is never read.
      *
      * @return \Titon\Event\CallStackList
      */
     public function getCallStack(): CallStackList {
-        return $this->_stack;
+        $stack = $this->_stack;
+
+        if ($stack === null) {
+            $stack = Vector {};
+
+        } else if ($this->_stackShared) {
+            $stack = $stack->toVector();
+        }
+
+        $this->_stack = $stack;
+        $this->_stackShared = false;
+
+        return $stack;
     }
 
     /**
@@ -96,7 +126,7 @@ class Event {
      * @return mixed
      */
     public function getData(string $key = ''): mixed {
-        return Col::get($this->_data, $key);
+        return Col::get($this->_getDataMap(), $key);
     }
 
     /**
@@ -135,6 +165,19 @@ class Event {
         return $this->_time;
     }
 
+    /**
+     * Return the callers of the async observers that timed out.
+     *
+     * @return \Titon\Event\CallStackList
+     */
+    public function getTimeouts(): CallStackList {
+        if ($this->_timeouts === null) {
+            $this->_timeouts = Vector {};
+        }
+
+        return $this->_timeouts;
+    }
+
     /**
      * Check if the event has stopped.
      *
@@ -144,6 +187,15 @@ class Event {
         return $this->_stopped;
     }
 
+    /**
+     * Check if any async observers timed out.
+     *
+     * @return bool
+     */
+    public function isTimedOut(): bool {
+        return ($this->_timeouts !== null && $this->_timeouts->count() > 0);
+    }
+
     /**
      * Increase the notify counter if the event has not stopped.
      *
@@ -158,13 +210,15 @@ class Event {
     }
 
     /**
-     * Set the call stack for the current event.
+     * Set the call stack for the current event. The stack is not copied until it is read,
+     * as the emitter shares it between events.
      *
      * @param \Titon\Event\CallStackList $stack
      * @return $this
      */
     public function setCallStack(CallStackList $stack): this {
         $this->_stack = $stack;
+        $this->_stackShared = true;
 
         return $this;
     }
@@ -177,7 +231,7 @@ class Event {
      * @return $this
      */
     public function setData(string $key, mixed $value): this {
-        Col::set($this->_data, $key, $value);
+        Col::set($this->_getDataMap(), $key, $value);
 
         return $this;
     }
@@ -205,4 +259,30 @@ class Event {
         return $this;
     }
 
+    /**
+     * Mark an async observer as timed out. The observer will no longer be waited on.
+     *
+     * @param string $caller
+     * @return $this
+     */
+    public function timeout(string $caller): this {
+        $timeouts = $this->getTimeouts();
+        $timeouts[] = $caller;
+
+        return $this;
+    }
+
+    /**
+     * Return the data map, and create it on first use.
+     *
+     * @return \Titon\Common\DataMap
+     */
+    protected function _getDataMap(): DataMap {
+        if ($this->_data === null) {
+            $this->_data = Map {};
+        }
+
+        return $this->_data;
+    }
+
 }
\ No newline at end of file
@@ -0,0 +1,259 @@
+<?hh // strict
+/**
+ * @copyright   2010-2015, The Titon Project
+ * @license     http://opensource.org/licenses/bsd-license.php
+ * @link        http://titon.io
+ */
+
+namespace Titon\Event;
+
+type EventIndexMap = Map<string, EventIndex>;
+
+/**
+ * The EventIndex is a trie of event keys split into dot separated segments, where each index is a single node.
+ * It is used to resolve which wildcard keys match a concrete key, and which concrete keys match a wildcard key,
+ * by walking the segments of the key instead of testing every registered key.
+ *
+ * A `*` segment matches a single segment, while a `**` segment matches one or more segments (a namespace).
+ * Partial wildcards within a segment, like `rendered*`, are also supported.
+ *
+ * @package Titon\Event
+ */
+class EventIndex {
+
+    const string WILDCARD = '*';
+    const string NAMESPACE_WILDCARD = '**';
+
+    /**
+     * Child nodes keyed by segment.
+     *
+     * @var \Titon\Event\EventIndexMap
+     */
+    protected EventIndexMap $_children = Map {};
+
+    /**
+     * Keys that end at this node.
+     *
+     * @var Set<string>
+     */
+    protected Set<string> $_keys = Set {};
+
+    /**
+     * Child segments that contain a partial wildcard, mapped to their compiled regex.
+     *
+     * @var Map<string, string>
+     */
+    protected Map<string, string> $_partials = Map {};
+
+    /**
+     * Add a key to the index.
+     *
+     * @param string $key
+     * @return $this
+     */
+    public function add(string $key): this {
+        $node = $this;
+
+        foreach (explode('.', $key) as $segment) {
+            $node = $node->makeChild($segment);
+        }
+
+        $node->_keys[] = $key;
+
+        return $this;
+    }
+
+    /**
+     * Return all keys in the index that are matched by a wildcard key, in insertion order of their segments.
+     *
+     * @param string $pattern
+     * @return Vector<string>
+     */
+    public function expand(string $pattern): Vector<string> {
+        $found = Set {};
+
+        $this->_expand(explode('.', $pattern), 0, $found);
+
+        return $found->toVector();
+    }
+
+    /**
+     * Return a child node by segment, or null if it does not exist.
+     *
+     * @param string $segment
+     * @return \Titon\Event\EventIndex
+     */
+    public function getChild(string $segment): ?EventIndex {
+        return $this->_children->get($segment);
+    }
+
+    /**
+     * Return the keys that end at this node.
+     *
+     * @return Set<string>
+     */
+    public function getKeys(): Set<string> {
+        return $this->_keys;
+    }
+
+    /**
+     * Return true if the index contains no keys.
+     *
+     * @return bool
+     */
+    public function isEmpty(): bool {
+        return (!$this->_keys && !$this->_children);
+    }
+
+    /**
+     * Return a child node by segment, creating it if it does not exist.
+     *
+     * @param string $segment
+     * @return \Titon\Event\EventIndex
+     */
+    public function makeChild(string $segment): EventIndex {
+        if (!$this->_children->contains($segment)) {
+            $this->_children[$segment] = new EventIndex();
+
+            if ($segment !== self::WILDCARD && $segment !== self::NAMESPACE_WILDCARD && strpos($segment, '*') !== false) {
+                $this->_partials[$segment] = '/^' . str_replace('\*', '[-\w]+', preg_quote($segment, '/')) . '$/i';
+            }
+        }
+
+        return $this->_children[$segment];
+    }
+
+    /**
+     * Return all wildcard keys in the index that match a concrete key.
+     *
+     * @param string $key
+     * @return Vector<string>
+     */
+    public function match(string $key): Vector<string> {
+        $found = Set {};
+
+        $this->_match(explode('.', $key), 0, $found);
+
+        return $found->toVector();
+    }
+
+    /**
+     * Remove a key from the index, and prune the nodes that no longer lead to a key.
+     *
+     * @param string $key
+     * @return $this
+     */
+    public function remove(string $key): this {
+        $this->_remove($key, explode('.', $key), 0);
+
+        return $this;
+    }
+
+    /**
+     * Collect the keys below this node that match the remaining pattern segments.
+     *
+     * @param array<string> $segments
+     * @param int $depth
+     * @param Set<string> $found
+     */
+    protected function _expand(array<string> $segments, int $depth, Set<string> $found): void {
+        if ($depth === count($segments)) {
+            $found->addAll($this->_keys);
+
+            return;
+        }
+
+        $segment = $segments[$depth];
+
+        if ($segment === self::NAMESPACE_WILDCARD) {
+            foreach ($this->_children as $child) {
+                $child->_expand($segments, $depth + 1, $found);
+                $child->_expand($segments, $depth, $found);
+            }
+
+        } else if ($segment === self::WILDCARD) {
+            foreach ($this->_children as $child) {
+                $child->_expand($segments, $depth + 1, $found);
+            }
+
+        } else if (strpos($segment, '*') !== false) {
+            $pattern = '/^' . str_replace('\*', '[-\w]+', preg_quote($segment, '/')) . '$/i';
+
+            foreach ($this->_children as $name => $child) {
+                if (preg_match($pattern, $name)) {
+                    $child->_expand($segments, $depth + 1, $found);
+                }
+            }
+
+        } else if ($child = $this->getChild($segment)) {
+            $child->_expand($segments, $depth + 1, $found);
+        }
+    }
+
+    /**
+     * Collect the keys below this node whose wildcard segments match the remaining key segments.
+     * Only the exact, wildcard, and partial wildcard children are followed, so the cost is bound by the key depth.
+     *
+     * @param array<string> $segments
+     * @param int $depth
+     * @param Set<string> $found
+     */
+    protected function _match(array<string> $segments, int $depth, Set<string> $found): void {
+        $count = count($segments);
+
+        if ($depth === $count) {
+            $found->addAll($this->_keys);
+
+            return;
+        }
+
+        $segment = $segments[$depth];
+
+        if ($child = $this->getChild($segment)) {
+            $child->_match($segments, $depth + 1, $found);
+        }
+
+        if ($segment !== self::WILDCARD && ($child = $this->getChild(self::WILDCARD))) {
+            $child->_match($segments, $depth + 1, $found);
+        }
+
+        // A namespace wildcard consumes one or more segments
+        if ($child = $this->getChild(self::NAMESPACE_WILDCARD)) {
+            for ($i = $depth + 1; $i <= $count; $i++) {
+                $child->_match($segments, $i, $found);
+            }
+        }
+
+        foreach ($this->_partials as $name => $pattern) {
+            if (preg_match($pattern, $segment)) {
+                $this->_children[$name]->_match($segments, $depth + 1, $found);
+            }
+        }
+    }
+
+    /**
+     * Remove a key below this node and return true if this node no longer leads to a key.
+     *
+     * @param string $key
+     * @param array<string> $segments
+     * @param int $depth
+     * @return bool
+     */
+    protected function _remove(string $key, array<string> $segments, int $depth): bool {
+        if ($depth === count($segments)) {
+            $this->_keys->remove($key);
+
+        } else {
+            $segment = $segments[$depth];
+            $child = $this->getChild($segment);
+
+            if ($child !== null && $child->_remove($key, $segments, $depth + 1)) {
+                $this->_children->remove($segment);
+                $this->_partials->remove($segment);
+            }
+        }
+
+        return $this->isEmpty();
+    }
+
+}
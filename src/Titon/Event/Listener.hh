@@ -12,6 +12,8 @@ type ListenerOption = shape('method' => string, 'priority' => int, 'once' => boo
 
 /**
  * The Listener interface defines groups of observers to register for events.
+ * Listeners whose events do not depend on instance state should implement StaticListener instead,
+ * so that their wiring is only resolved once per class.
  *
  * @package Titon\Event
  */
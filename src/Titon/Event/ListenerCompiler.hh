@@ -0,0 +1,241 @@
+<?hh // strict
+/**
+ * @copyright   2010-2015, The Titon Project
+ * @license     http://opensource.org/licenses/bsd-license.php
+ * @link        http://titon.io
+ */
+
+namespace Titon\Event;
+
+use Titon\Common\Annotator;
+use Titon\Io\File;
+use \ReflectionMethod;
+
+type CompiledWiringMap = array<string, array<ListenerWiring>>;
+type ListenerWiring = shape('event' => string, 'method' => string, 'priority' => int, 'once' => bool, 'async' => bool);
+type ListenerWiringList = Vector<ListenerWiring>;
+
+/**
+ * The ListenerCompiler resolves the observers of a Listener, or of <<Observer>> method annotations, into a flat list
+ * of wiring that can be bulk registered into an emitter. Wiring of annotations and of a StaticListener is resolved
+ * once per class and held in a static map, so the options parsing and reflection are not repeated for every instance.
+ * Other listeners may return different events per instance, so are resolved every time.
+ *
+ * The map can be exported into a generated Hack file and loaded on bootstrap, which skips resolving entirely.
+ *
+ * {{{
+ *      ListenerCompiler::write('/path/to/listeners.hh'); // After all listeners have been wired
+ *      ListenerCompiler::load('/path/to/listeners.hh'); // On bootstrap
+ * }}}
+ *
+ * @package Titon\Event
+ */
+class ListenerCompiler {
+
+    const string ANNOTATION = 'annotation';
+    const string LISTENER = 'listener';
+
+    /**
+     * Resolved wiring keyed by type and class name.
+     *
+     * @var Map<string, \Titon\Event\ListenerWiringList>
+     */
+    protected static Map<string, ListenerWiringList> $_wiring = Map {};
+
+    /**
+     * Export all resolved wiring.
+     *
+     * @return \Titon\Event\CompiledWiringMap
+     */
+    public static function compile(): CompiledWiringMap {
+        $compiled = [];
+
+        foreach (static::$_wiring as $key => $wiring) {
+            $compiled[$key] = $wiring->toArray();
+        }
+
+        return $compiled;
+    }
+
+    /**
+     * Resolve the wiring for all methods with an <<Observer($event[, $priority[, $once]])>> annotation.
+     *
+     * @param \Titon\Common\Annotator $object
+     * @return \Titon\Event\ListenerWiringList
+     */
+    public static function compileAnnotations(Annotator $object): ListenerWiringList {
+        $wiring = Vector {};
+
+        foreach ($object->getAnnotatedMethods() as $method) {
+            if ($annotation = $object->getMethodAnnotation($method, 'Observer')) {
+                $wiring[] = shape(
+                    'event' => (string) $annotation[0],
+                    'method' => $method,
+                    'priority' => (int) $annotation->get(1) ?: 0,
+                    'once' => (bool) $annotation->get(2) ?: false,
+                    'async' => (new ReflectionMethod($object, $method))->isAsync()
+                );
+            }
+        }
+
+        return $wiring;
+    }
+
+    /**
+     * Resolve the wiring for the events returned from `Listener::registerEvents()`.
+     *
+     * @param \Titon\Event\Listener $listener
+     * @return \Titon\Event\ListenerWiringList
+     */
+    public static function compileListener(Listener $listener): ListenerWiringList {
+        $wiring = Vector {};
+
+        foreach ($listener->registerEvents() as $event => $options) {
+            foreach (static::parseOptions($options) as $opt) {
+                $wiring[] = shape(
+                    'event' => $event,
+                    'method' => $opt['method'],
+                    'priority' => $opt['priority'],
+                    'once' => $opt['once'],
+                    'async' => (new ReflectionMethod($listener, $opt['method']))->isAsync()
+                );
+            }
+        }
+
+        return $wiring;
+    }
+
+    /**
+     * Remove all resolved wiring.
+     */
+    public static function flush(): void {
+        static::$_wiring->clear();
+    }
+
+    /**
+     * Generate the source of the wiring file.
+     *
+     * @return string
+     */
+    public static function generate(): string {
+        return sprintf("<?hh\n/**\n * Generated by %s on %s. Do not edit this file manually.\n */\n\nreturn %s;\n",
+            static::class,
+            date('Y-m-d H:i:s'),
+            var_export(static::compile(), true));
+    }
+
+    /**
+     * Return the annotation wiring for an object, resolving it if it has not been for the class.
+     *
+     * @param \Titon\Common\Annotator $object
+     * @return \Titon\Event\ListenerWiringList
+     */
+    public static function getAnnotationWiring(Annotator $object): ListenerWiringList {
+        $key = static::getKey(self::ANNOTATION, get_class($object));
+
+        if (!static::$_wiring->contains($key)) {
+            static::$_wiring[$key] = static::compileAnnotations($object);
+        }
+
+        return static::$_wiring[$key];
+    }
+
+    /**
+     * Return the key that wiring is stored under.
+     *
+     * @param string $type
+     * @param string $class
+     * @return string
+     */
+    public static function getKey(string $type, string $class): string {
+        return $type . ':' . $class;
+    }
+
+    /**
+     * Return the listener wiring for a listener. The wiring of a `StaticListener` is only resolved
+     * if it has not been for the class.
+     *
+     * @param \Titon\Event\Listener $listener
+     * @return \Titon\Event\ListenerWiringList
+     */
+    public static function getListenerWiring(Listener $listener): ListenerWiringList {
+        if (!$listener instanceof StaticListener) {
+            return static::compileListener($listener);
+        }
+
+        $key = static::getKey(self::LISTENER, get_class($listener));
+
+        if (!static::$_wiring->contains($key)) {
+            static::$_wiring[$key] = static::compileListener($listener);
+        }
+
+        return static::$_wiring[$key];
+    }
+
+    /**
+     * Return true if wiring has been resolved or loaded for a key.
+     *
+     * @param string $key
+     * @return bool
+     */
+    public static function has(string $key): bool {
+        return static::$_wiring->contains($key);
+    }
+
+    /**
+     * Load wiring from a file that was generated with `write()`.
+     *
+     * @param string $path
+     */
+    public static function load(string $path): void {
+        foreach (include_file($path) as $key => $wiring) {
+            static::$_wiring[$key] = new Vector($wiring);
+        }
+    }
+
+    /**
+     * Parse the options from a listener into an indexed array of object method callbacks.
+     *
+     * @param array|string $options
+     * @return Vector<ListenerOption>
+     */
+    public static function parseOptions(mixed $options): Vector<ListenerOption> {
+        if (!$options instanceof Vector) {
+            $options = new Vector([$options]);
+        }
+
+        invariant($options instanceof Vector, 'Event options must be a vector');
+
+        $parsed = Vector {};
+
+        foreach ($options as $option) {
+            $settings = shape(
+                'method' => '',
+                'priority' => 0,
+                'once' => false
+            );
+
+            if (is_string($option)) {
+                $settings['method'] = $option;
+
+            } else if ($option instanceof Map) {
+                $settings = array_merge($settings, $option->toArray());
+            }
+
+            $parsed[] = $settings;
+        }
+
+        return $parsed;
+    }
+
+    /**
+     * Generate the wiring file and write it to the file system.
+     *
+     * @param string $path
+     * @return bool
+     */
+    public static function write(string $path): bool {
+        return (new File($path, true))->write(static::generate());
+    }
+
+}
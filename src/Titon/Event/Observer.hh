@@ -35,6 +35,13 @@ class Observer {
      */
     protected ObserverCallback $_callback;
 
+    /**
+     * The class name, method, or function for the callback.
+     *
+     * @var string
+     */
+    protected string $_caller = '{closure}';
+
     /**
      * Has the callback been executed.
      *
@@ -57,22 +64,36 @@ class Observer {
     protected int $_priority;
 
     /**
-     * Setup the observer and auto-detect if the callback is async.
+     * Setup the observer, resolve the caller name, and auto-detect if the callback is async.
+     * If it is already known whether the callback is async, the reflection is skipped.
      *
      * @param \Titon\Event\ObserverCallback $callback
      * @param int $priority
      * @param bool $once
+     * @param bool $async
      */
-    public function __construct(ObserverCallback $callback, int $priority, bool $once) {
+    public function __construct(ObserverCallback $callback, int $priority, bool $once, ?bool $async = null) {
         $this->_callback = $callback;
         $this->_priority = $priority;
         $this->_once = $once;
 
-        if (is_array($callback)) {
+        if ($async !== null) {
+            $this->_async = $async;
+
+        } else if (is_array($callback)) {
             $this->_async = (new ReflectionMethod($callback[0], $callback[1]))->isAsync();
         } else {
             $this->_async = (new ReflectionFunction($callback))->isAsync();
         }
+
+        // Use `is_callable()` to fetch the callable name
+        if (!$callback instanceof Closure) {
+            $caller = '';
+
+            is_callable($callback, true, $caller);
+
+            $this->_caller = $caller;
+        }
     }
 
     /**
@@ -114,15 +135,7 @@ class Observer {
      * @return string
      */
     public function getCaller(): string {
-        $caller = '{closure}';
-        $callback = $this->getCallback();
-
-        // Use `is_callable()` to fetch the callable name
-        if (!$callback instanceof Closure) {
-            is_callable($callback, true, $caller);
-        }
-
-        return $caller;
+        return $this->_caller;
     }
 
     /**
@@ -21,18 +21,12 @@ trait ObserverAnnotation {
 
     /**
      * Wire up observers by looking for method annotations. The method in turn will become a callback.
-     * The following format is supported.
+     * The annotations are resolved once per class by the listener compiler. The following format is supported.
      *
      *      <<Observer($event[, $priority[, $once]])>>
      */
     private function __wireObserverAnnotations(): void {
-        foreach ($this->getAnnotatedMethods() as $method) {
-            if ($annotation = $this->getMethodAnnotation($method, 'Observer')) {
-                // UNSAFE
-                // Since inst_meth() requires literal strings and we are passing variables
-                $this->on((string) $annotation[0], inst_meth($this, $method), (int) $annotation->get(1) ?: 0, (bool) $annotation->get(2) ?: false);
-            }
-        }
+        $this->getEmitter()->registerWiring($this, ListenerCompiler::getAnnotationWiring($this));
     }
 
 }
\ No newline at end of file
@@ -0,0 +1,159 @@
+<?hh // strict
+/**
+ * @copyright   2010-2015, The Titon Project
+ * @license     http://opensource.org/licenses/bsd-license.php
+ * @link        http://titon.io
+ */
+
+namespace Titon\Event;
+
+type ObserverMetric = shape('caller' => string, 'count' => int, 'time' => float, 'maxTime' => float, 'memory' => int);
+type ObserverMetricMap = Map<string, Map<string, ObserverMetric>>;
+
+/**
+ * The Profiler collects the wall time, memory delta, and call count of every notified observer,
+ * grouped by event and keyed by the observer caller. It is enabled for all emitters with `Emitter::setProfiler()`,
+ * and can summarize the slowest observers per event, which is useful to log at the end of a request.
+ *
+ * Async observers are measured from when they start until they finish, which includes the time
+ * other async observers ran in between, so their times should be read as an upper bound.
+ *
+ * @package Titon\Event
+ */
+class Profiler {
+
+    /**
+     * Metrics per event, per observer caller.
+     *
+     * @var \Titon\Event\ObserverMetricMap
+     */
+    protected ObserverMetricMap $_metrics = Map {};
+
+    /**
+     * Remove all metrics.
+     *
+     * @return $this
+     */
+    public function flush(): this {
+        $this->_metrics->clear();
+
+        return $this;
+    }
+
+    /**
+     * Return the metrics of all observers for an event, or for all events.
+     *
+     * @param string $event
+     * @return \Titon\Event\ObserverMetricMap
+     */
+    public function getMetrics(string $event = ''): ObserverMetricMap {
+        if (!$event) {
+            return $this->_metrics;
+        }
+
+        $metrics = Map {};
+
+        if ($this->_metrics->contains($event)) {
+            $metrics[$event] = $this->_metrics[$event];
+        }
+
+        return $metrics;
+    }
+
+    /**
+     * Return the slowest observers per event, ordered by their total time, with the slowest events first.
+     *
+     * @param int $limit
+     * @return Map<string, Vector<ObserverMetric>>
+     */
+    public function getSlowest(int $limit = 5): Map<string, Vector<ObserverMetric>> {
+        $totals = [];
+
+        foreach ($this->_metrics as $event => $observers) {
+            $totals[$event] = array_sum(array_map($metric ==> $metric['time'], $observers->toArray()));
+        }
+
+        arsort($totals);
+
+        $slowest = Map {};
+
+        foreach ($totals as $event => $total) {
+            $metrics = $this->_metrics[$event]->toValuesArray();
+
+            usort($metrics, (ObserverMetric $a, ObserverMetric $b) ==> {
+                if ($a['time'] == $b['time']) {
+                    return 0;
+                }
+
+                return ($a['time'] > $b['time']) ? -1 : 1;
+            });
+
+            $slowest[(string) $event] = new Vector(array_slice($metrics, 0, max(1, $limit)));
+        }
+
+        return $slowest;
+    }
+
+    /**
+     * Record a single notification of an observer.
+     *
+     * @param string $event
+     * @param string $caller
+     * @param float $time
+     * @param int $memory
+     * @return $this
+     */
+    public function record(string $event, string $caller, float $time, int $memory): this {
+        if (!$this->_metrics->contains($event)) {
+            $this->_metrics[$event] = Map {};
+        }
+
+        $observers = $this->_metrics[$event];
+        $metric = $observers->get($caller);
+
+        if ($metric === null) {
+            $metric = shape(
+                'caller' => $caller,
+                'count' => 0,
+                'time' => 0.0,
+                'maxTime' => 0.0,
+                'memory' => 0
+            );
+        }
+
+        $metric['count']++;
+        $metric['time'] += $time;
+        $metric['maxTime'] = max($metric['maxTime'], $time);
+        $metric['memory'] += $memory;
+
+        $observers[$caller] = $metric;
+
+        return $this;
+    }
+
+    /**
+     * Format the slowest observers per event as a human readable string that can be logged.
+     *
+     * @param int $limit
+     * @return string
+     */
+    public function summary(int $limit = 5): string {
+        $output = '';
+
+        foreach ($this->getSlowest($limit) as $event => $metrics) {
+            $output .= sprintf('[%s]', $event) . PHP_EOL;
+
+            foreach ($metrics as $metric) {
+                $output .= sprintf('    %s: %s ms total, %s ms max, %s calls, %s bytes',
+                    $metric['caller'],
+                    number_format($metric['time'] * 1000, 2),
+                    number_format($metric['maxTime'] * 1000, 2),
+                    $metric['count'],
+                    number_format($metric['memory'])) . PHP_EOL;
+            }
+        }
+
+        return $output;
+    }
+
+}
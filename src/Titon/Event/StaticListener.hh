@@ -0,0 +1,19 @@
+<?hh // strict
+/**
+ * @copyright   2010-2015, The Titon Project
+ * @license     http://opensource.org/licenses/bsd-license.php
+ * @link        http://titon.io
+ */
+
+namespace Titon\Event;
+
+/**
+ * The StaticListener interface marks a listener whose `registerEvents()` returns the same observers
+ * for every instance of the class, as it does not depend on instance state. The wiring of these listeners
+ * is resolved once per class by the `ListenerCompiler`, and can be compiled into a generated file.
+ *
+ * @package Titon\Event
+ */
+interface StaticListener extends Listener {
+
+}
@@ -19,11 +19,30 @@ interface Subject {
      */
     public function emit(string $event, ParamList $params): Event;
 
+    /**
+     * Queue an event to be emitted after the response has been sent. If coalesced, an already queued
+     * event with the same key is updated with the params instead of being queued again.
+     * Return false if the queue is full.
+     *
+     * @param string $event
+     * @param \Titon\Event\ParamList $params
+     * @param bool $coalesce
+     * @return bool
+     */
+    public function emitDeferred(string $event, ParamList $params, bool $coalesce = false): bool;
+
     /**
      * @see \Titon\Event\Emitter::emitMany()
      */
     public function emitMany(mixed $event, ParamList $params): EventMap;
 
+    /**
+     * Return the emitter.
+     *
+     * @return \Titon\Event\Emitter
+     */
+    public function getEmitter(): Emitter;
+
     /**
      * Register an observer or listener to only trigger once and then remove itself from the list.
      *
@@ -11,6 +11,7 @@ namespace Titon\Http\Server;
 use Psr\Http\Message\StreamableInterface;
 use Titon\Common\Exception\InvalidArgumentException;
 use Titon\Common\FactoryAware;
+use Titon\Event\DeferredQueue;
 use Titon\Http\Cookie;
 use Titon\Http\Message;
 use Titon\Http\Http;
@@ -21,6 +22,7 @@ use Titon\Http\IncomingRequestAware;
 use Titon\Utility\Config;
 use Titon\Utility\Format;
 use Titon\Utility\Number;
+use Titon\Utility\Registry;
 use Titon\Utility\Str;
 use Titon\Utility\Time;
 
@@ -611,16 +613,19 @@ class Response extends Message implements OutgoingResponse {
             $this->setHeader('Content-MD5', base64_encode(pack('H*', md5($contents))));
         }
 
-        // Return while in debug
-        if ($this->isDebugging()) {
-            return $contents;
-        }
+        // Only output while not in debug
+        if (!$this->isDebugging()) {
+            $this->sendHeaders();
+            $this->sendBody();
 
-        $this->sendHeaders();
-        $this->sendBody();
+            if (function_exists('fastcgi_finish_request')) {
+                fastcgi_finish_request();
+            }
+        }
 
-        if (function_exists('fastcgi_finish_request')) {
-            fastcgi_finish_request();
+        // Emit deferred events now that the client has the response
+        if (Registry::has(DeferredQueue::class)) {
+            DeferredQueue::registry()->dispatch();
         }
 
         return $contents;
@@ -0,0 +1,28 @@
+<?hh // strict
+/**
+ * @copyright   2010-2015, The Titon Project
+ * @license     http://opensource.org/licenses/bsd-license.php
+ * @link        http://titon.io
+ */
+
+namespace Titon\Route;
+
+/**
+ * Async filters are triggered like regular filters, but can await I/O, like authentication lookups.
+ * Consecutive async filters in a route's filter chain are awaited concurrently.
+ *
+ * @package Titon\Route
+ */
+interface AsyncFilter {
+
+    /**
+     * Method to be triggered once a route has been matched.
+     * Return a non-null value to short-circuit the pipeline and use the value as the response.
+     *
+     * @param \Titon\Route\Router $router
+     * @param \Titon\Route\Route $route
+     * @return Awaitable<mixed>
+     */
+    public function filter(Router $router, Route $route): Awaitable<mixed>;
+
+}
@@ -8,6 +8,7 @@
 namespace Titon\Route;
 
 use Titon\Route\Exception\NoMatchException;
+use Titon\Route\Exception\UncompilableRouteException;
 use \ReflectionFunction;
 
 type RouteCallback = (function(...): mixed);
@@ -52,6 +53,16 @@ class CallbackRoute extends Route {
         return $callback->invokeArgs($this->_getArguments($callback)->toArray());
     }
 
+    /**
+     * Callbacks cannot be exported, so throw an exception.
+     *
+     * @return \Titon\Route\CompiledRoute
+     * @throws \Titon\Route\Exception\UncompilableRouteException
+     */
+    public function export(): CompiledRoute {
+        throw new UncompilableRouteException(sprintf('Callback route %s cannot be exported', $this->getPath()));
+    }
+
     /**
      * Return the callback function.
      *
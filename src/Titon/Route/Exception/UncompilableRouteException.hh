@@ -0,0 +1,17 @@
+<?hh // strict
+/**
+ * @copyright   2010-2015, The Titon Project
+ * @license     http://opensource.org/licenses/bsd-license.php
+ * @link        http://titon.io
+ */
+
+namespace Titon\Route\Exception;
+
+/**
+ * Exception thrown when a route contains callbacks and cannot be exported to a static dispatch table.
+ *
+ * @package Titon\Route\Exception
+ */
+class UncompilableRouteException extends \DomainException {
+
+}
\ No newline at end of file
@@ -18,11 +18,12 @@ interface Filter {
     /**
      * Method to be triggered once a route has been matched.
      * The matching route and the router are passed as arguments.
+     * Return a non-null value to short-circuit the pipeline and use the value as the response.
      *
      * @param \Titon\Route\Router $router
      * @param \Titon\Route\Route $route
-     * @return void
+     * @return mixed
      */
-    public function filter(Router $router, Route $route): void;
+    public function filter(Router $router, Route $route): mixed;
 
 }
\ No newline at end of file
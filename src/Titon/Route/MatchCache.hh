@@ -0,0 +1,206 @@
+<?hh // strict
+/**
+ * @copyright   2010-2015, The Titon Project
+ * @license     http://opensource.org/licenses/bsd-license.php
+ * @link        http://titon.io
+ */
+
+namespace Titon\Route;
+
+use Titon\Cache\Item;
+use Titon\Cache\Storage;
+
+type MatchResult = shape('route' => string, 'url' => string, 'params' => array<string, mixed>);
+type MatchResultMap = Map<string, MatchResult>;
+
+/**
+ * The MatchCache memoizes the results of `Router::match()` so that frequently requested URLs skip the matcher.
+ * Results are held in a least recently used list that is bounded by entry count, and can optionally be shared
+ * across requests through a cache storage engine, in which case entries are bounded by their expiration.
+ *
+ * Every lookup is tied to the fingerprint of the route table, so when routes change, previous results are discarded.
+ *
+ * @package Titon\Route
+ */
+class MatchCache {
+
+    /**
+     * The maximum number of results to keep in memory.
+     *
+     * @var int
+     */
+    protected int $_capacity = 500;
+
+    /**
+     * When shared results should expire.
+     *
+     * @var mixed
+     */
+    protected mixed $_expires = '+1 hour';
+
+    /**
+     * The route table fingerprint the in-memory results belong to.
+     *
+     * @var string
+     */
+    protected string $_fingerprint = '';
+
+    /**
+     * Matched results, in least to most recently used order.
+     *
+     * @var \Titon\Route\MatchResultMap
+     */
+    protected MatchResultMap $_results = Map {};
+
+    /**
+     * Storage engine to share results across requests.
+     *
+     * @var \Titon\Cache\Storage
+     */
+    protected ?Storage $_storage;
+
+    /**
+     * Set the capacity, and the optional storage engine and expiration for sharing results.
+     *
+     * @param int $capacity
+     * @param \Titon\Cache\Storage $storage
+     * @param mixed $expires
+     */
+    public function __construct(int $capacity = 500, ?Storage $storage = null, mixed $expires = '+1 hour') {
+        $this->_capacity = max(1, $capacity);
+        $this->_storage = $storage;
+        $this->_expires = $expires;
+    }
+
+    /**
+     * Return the number of results held in memory.
+     *
+     * @return int
+     */
+    public function count(): int {
+        return count($this->_results);
+    }
+
+    /**
+     * Remove all results held in memory.
+     *
+     * @return $this
+     */
+    public function flush(): this {
+        $this->_results->clear();
+
+        return $this;
+    }
+
+    /**
+     * Return a matched result for a URL, first from memory, then from the storage engine.
+     *
+     * @param string $fingerprint
+     * @param string $key
+     * @return \Titon\Route\MatchResult
+     */
+    public function get(string $fingerprint, string $key): ?MatchResult {
+        $this->_validate($fingerprint);
+
+        $result = $this->_results->get($key);
+
+        // Move to the end of the list as it was most recently used
+        if ($result !== null) {
+            $this->_results->remove($key);
+
+            return $this->_results[$key] = $result;
+        }
+
+        $item = $this->getStorage()?->getItem($this->_getStorageKey($fingerprint, $key));
+
+        if ($item !== null && $item->isHit()) {
+            $result = $item->get();
+
+            // Results written in a previous format are ignored
+            if (is_array($result) && array_key_exists('params', $result)) {
+                $this->_store($key, $result);
+
+                return $result;
+            }
+        }
+
+        return null;
+    }
+
+    /**
+     * Return the maximum number of results to keep in memory.
+     *
+     * @return int
+     */
+    public function getCapacity(): int {
+        return $this->_capacity;
+    }
+
+    /**
+     * Return the storage engine.
+     *
+     * @return \Titon\Cache\Storage
+     */
+    public function getStorage(): ?Storage {
+        return $this->_storage;
+    }
+
+    /**
+     * Store a matched result for a URL in memory, and in the storage engine.
+     *
+     * @param string $fingerprint
+     * @param string $key
+     * @param \Titon\Route\MatchResult $result
+     * @return $this
+     */
+    public function set(string $fingerprint, string $key, MatchResult $result): this {
+        $this->_validate($fingerprint);
+        $this->_store($key, $result);
+
+        $this->getStorage()?->save(new Item($this->_getStorageKey($fingerprint, $key), $result, $this->_expires));
+
+        return $this;
+    }
+
+    /**
+     * Return the key to use in the storage engine. The fingerprint is part of the key,
+     * so results for a previous route table will never be returned.
+     *
+     * @param string $fingerprint
+     * @param string $key
+     * @return string
+     */
+    protected function _getStorageKey(string $fingerprint, string $key): string {
+        return 'route.match.' . md5($fingerprint . $key);
+    }
+
+    /**
+     * Store a result in memory and evict the least recently used result if the capacity has been reached.
+     *
+     * @param string $key
+     * @param \Titon\Route\MatchResult $result
+     */
+    protected function _store(string $key, MatchResult $result): void {
+        if ($this->_results->contains($key)) {
+            $this->_results->remove($key);
+
+        } else if (count($this->_results) >= $this->_capacity) {
+            $this->_results->remove($this->_results->firstKey());
+        }
+
+        $this->_results[$key] = $result;
+    }
+
+    /**
+     * Discard all results held in memory if the route table has changed.
+     *
+     * @param string $fingerprint
+     */
+    protected function _validate(string $fingerprint): void {
+        if ($this->_fingerprint !== $fingerprint) {
+            $this->_fingerprint = $fingerprint;
+            $this->_results->clear();
+        }
+    }
+
+}
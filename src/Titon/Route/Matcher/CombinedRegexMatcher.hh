@@ -0,0 +1,212 @@
+<?hh // strict
+/**
+ * @copyright   2010-2015, The Titon Project
+ * @license     http://opensource.org/licenses/bsd-license.php
+ * @link        http://titon.io
+ */
+
+namespace Titon\Route\Matcher;
+
+use Titon\Route\Matcher;
+use Titon\Route\Route;
+use Titon\Route\RouteMap;
+
+type RegexChunk = shape('regex' => string, 'routes' => Map<int, int>);
+type RegexChunkList = Vector<RegexChunk>;
+
+/**
+ * Combines the compiled regex of multiple routes into a few large alternation patterns, which reduces the amount
+ * of `preg_match()` calls from one per route to one per chunk. Each route within a chunk is padded with empty groups
+ * so that the number of captured groups can be used to determine which route was matched.
+ *
+ * @package Titon\Route\Matcher
+ */
+class CombinedRegexMatcher implements Matcher {
+
+    /**
+     * The approximate number of routes to combine into a single pattern.
+     *
+     * @var int
+     */
+    protected int $_chunkSize = 20;
+
+    /**
+     * List of combined patterns.
+     *
+     * @var \Titon\Route\Matcher\RegexChunkList
+     */
+    protected RegexChunkList $_chunks = Vector {};
+
+    /**
+     * The number of capture groups for each route, indexed by mapping order.
+     *
+     * @var Vector<int>
+     */
+    protected Vector<int> $_groups = Vector {};
+
+    /**
+     * Routes indexed by their mapping order.
+     *
+     * @var Vector<Route>
+     */
+    protected Vector<Route> $_routes = Vector {};
+
+    /**
+     * The route map the patterns were built from.
+     *
+     * @var \Titon\Route\RouteMap
+     */
+    protected ?RouteMap $_source;
+
+    /**
+     * The number of routes in the source route map.
+     *
+     * @var int
+     */
+    protected int $_sourceCount = 0;
+
+    /**
+     * Set the approximate chunk size.
+     *
+     * @param int $chunkSize
+     */
+    public function __construct(int $chunkSize = 20) {
+        $this->_chunkSize = max(1, $chunkSize);
+    }
+
+    /**
+     * Compile all routes and combine their patterns into chunks.
+     *
+     * @param \Titon\Route\RouteMap $routes
+     * @return \Titon\Route\Matcher\RegexChunkList
+     */
+    public function build(RouteMap $routes): RegexChunkList {
+        $this->_chunks = Vector {};
+        $this->_groups = Vector {};
+        $this->_routes = Vector {};
+        $this->_source = $routes;
+        $this->_sourceCount = count($routes);
+
+        $total = $this->_sourceCount;
+
+        if (!$total) {
+            return $this->_chunks;
+        }
+
+        // Balance the chunks so the last one is not left with a few routes
+        $chunkSize = (int) ceil($total / ceil($total / $this->_chunkSize));
+        $patterns = [];
+        $map = Map {};
+        $groupCount = 0;
+
+        foreach ($routes as $route) {
+            $index = count($this->_routes);
+            // Alternatives of a branch reset group can not share names, so remove the names from captures
+            $compiled = preg_replace('/\(\?P<[a-z0-9_]+>/i', '(', $route->compile());
+            $groups = $this->countGroups($compiled);
+
+            $this->_routes[] = $route;
+            $this->_groups[] = $groups;
+
+            // Always pad with at least one group, so that trailing optional groups are not trimmed from the matches
+            $groupCount = max($groupCount + 1, $groups + 1);
+            $patterns[] = $compiled . str_repeat('()', $groupCount - $groups);
+            $map[$groupCount + 1] = $index;
+
+            if (count($patterns) >= $chunkSize) {
+                $this->_chunks[] = $this->_buildChunk($patterns, $map);
+                $patterns = [];
+                $map = Map {};
+                $groupCount = 0;
+            }
+        }
+
+        if ($patterns) {
+            $this->_chunks[] = $this->_buildChunk($patterns, $map);
+        }
+
+        return $this->_chunks;
+    }
+
+    /**
+     * Return the number of capture groups within a regex pattern.
+     *
+     * @param string $regex
+     * @return int
+     */
+    public function countGroups(string $regex): int {
+        $regex = preg_replace('/\\\\./', '', $regex); // Escaped characters
+        $regex = preg_replace('/\[[^\]]*\]/', '', $regex); // Character classes
+
+        return preg_match_all('/\((?!\?)|\(\?P?<[a-z_]/i', $regex);
+    }
+
+    /**
+     * Return the approximate chunk size.
+     *
+     * @return int
+     */
+    public function getChunkSize(): int {
+        return $this->_chunkSize;
+    }
+
+    /**
+     * Return the combined patterns, and rebuild them if the list of routes has changed.
+     *
+     * @param \Titon\Route\RouteMap $routes
+     * @return \Titon\Route\Matcher\RegexChunkList
+     */
+    public function getChunks(RouteMap $routes): RegexChunkList {
+        if ($this->_source !== $routes || $this->_sourceCount !== count($routes)) {
+            return $this->build($routes);
+        }
+
+        return $this->_chunks;
+    }
+
+    /**
+     * {@inheritdoc}
+     */
+    public function match(string $url, RouteMap $routes): ?Route {
+        foreach ($this->getChunks($routes) as $chunk) {
+            $matches = [];
+
+            if (!preg_match($chunk['regex'], $url, $matches)) {
+                continue;
+            }
+
+            $index = $chunk['routes'][count($matches)];
+            $route = $this->_routes[$index];
+
+            if ($route->isMethod() && $route->isSecure() && $route->isValid()) {
+                $route->match(array_slice($matches, 0, $this->_groups[$index] + 1));
+
+                return $route;
+            }
+
+            // The route failed its conditions, so match the remaining routes in the chunk individually
+            foreach ($chunk['routes'] as $next) {
+                if ($next > $index && $this->_routes[$next]->isMatch($url)) {
+                    return $this->_routes[$next];
+                }
+            }
+        }
+
+        return null;
+    }
+
+    /**
+     * Combine a list of patterns into a single branch reset alternation.
+     *
+     * @param array<string> $patterns
+     * @param Map<int, int> $map
+     * @return \Titon\Route\Matcher\RegexChunk
+     */
+    protected function _buildChunk(array<string> $patterns, Map<int, int> $map): RegexChunk {
+        return shape(
+            'regex' => '~^(?|' . implode('|', $patterns) . ')$~i',
+            'routes' => $map
+        );
+    }
+
+}
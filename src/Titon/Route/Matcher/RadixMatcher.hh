@@ -0,0 +1,183 @@
+<?hh // strict
+/**
+ * @copyright   2010-2015, The Titon Project
+ * @license     http://opensource.org/licenses/bsd-license.php
+ * @link        http://titon.io
+ */
+
+namespace Titon\Route\Matcher;
+
+use Titon\Route\Matcher;
+use Titon\Route\Route;
+use Titon\Route\RouteMap;
+
+/**
+ * Builds a segment based radix tree from the mapped routes, which is used to narrow down the list of routes
+ * that could possibly match a URL. Static segments are resolved through a hash lookup, while only the
+ * routes that contain tokens fall back to regex matching. Candidates are matched in the order they were mapped,
+ * so the first mapped route to match will win, just like the LoopMatcher.
+ *
+ * @package Titon\Route\Matcher
+ */
+class RadixMatcher implements Matcher {
+
+    /**
+     * Routes indexed by their mapping order.
+     *
+     * @var Vector<Route>
+     */
+    protected Vector<Route> $_routes = Vector {};
+
+    /**
+     * The route map the tree was built from.
+     *
+     * @var \Titon\Route\RouteMap
+     */
+    protected ?RouteMap $_source;
+
+    /**
+     * The number of routes in the source route map.
+     *
+     * @var int
+     */
+    protected int $_sourceCount = 0;
+
+    /**
+     * The root node of the tree.
+     *
+     * @var \Titon\Route\Matcher\RadixNode
+     */
+    protected RadixNode $_tree;
+
+    /**
+     * Instantiate an empty tree.
+     */
+    public function __construct() {
+        $this->_tree = new RadixNode();
+    }
+
+    /**
+     * Build the tree from a list of routes. Each route is placed at the node of its leading static segments.
+     *
+     * @param \Titon\Route\RouteMap $routes
+     * @return \Titon\Route\Matcher\RadixNode
+     */
+    public function build(RouteMap $routes): RadixNode {
+        $this->_tree = new RadixNode();
+        $this->_routes = Vector {};
+        $this->_source = $routes;
+        $this->_sourceCount = count($routes);
+
+        foreach ($routes as $route) {
+            $index = count($this->_routes);
+            $node = $this->_tree;
+            $parent = $node;
+            $dynamic = false;
+
+            $this->_routes[] = $route;
+
+            foreach ($this->_splitPath($route->getPath()) as $segment) {
+                if (!$this->isStaticSegment($segment)) {
+                    $dynamic = true;
+
+                    // An optional token that is followed by other characters in the same segment
+                    // will absorb the leading slash, so the previous segment may not be complete
+                    if (strpos($segment, '?') !== false && !preg_match('/^[\{\[\(\<][^\/]+\?[\}\]\)\>]$/', $segment)) {
+                        $node = $parent;
+                    }
+
+                    break;
+                }
+
+                $parent = $node;
+                $node = $node->makeChild(strtolower($segment));
+            }
+
+            if ($dynamic) {
+                $node->addDynamic($index);
+            } else {
+                $node->addStatic($index);
+            }
+        }
+
+        return $this->_tree;
+    }
+
+    /**
+     * Return the tree, and rebuild it if the list of routes has changed.
+     *
+     * @param \Titon\Route\RouteMap $routes
+     * @return \Titon\Route\Matcher\RadixNode
+     */
+    public function getTree(RouteMap $routes): RadixNode {
+        if ($this->_source !== $routes || $this->_sourceCount !== count($routes)) {
+            return $this->build($routes);
+        }
+
+        return $this->_tree;
+    }
+
+    /**
+     * Return true if the path segment contains no tokens or regex characters.
+     *
+     * @param string $segment
+     * @return bool
+     */
+    public function isStaticSegment(string $segment): bool {
+        return !preg_match('/[\{\}\[\]\(\)\<\>\\\\\+\*\?\^\$\|]/', $segment);
+    }
+
+    /**
+     * {@inheritdoc}
+     */
+    public function match(string $url, RouteMap $routes): ?Route {
+        $node = $this->getTree($routes);
+        $candidates = $node->getDynamic()->toVector();
+        $complete = true;
+
+        foreach ($this->_splitPath($url) as $segment) {
+            $node = $node->getChild(strtolower($segment));
+
+            if ($node === null) {
+                $complete = false;
+                break;
+            }
+
+            $candidates->addAll($node->getDynamic());
+        }
+
+        if ($complete && $node !== null) {
+            $candidates->addAll($node->getStatic());
+        }
+
+        // Match in the order the routes were mapped
+        sort($candidates);
+
+        foreach ($candidates as $index) {
+            $route = $this->_routes[$index];
+
+            if ($route->isMatch($url)) {
+                return $route;
+            }
+        }
+
+        return null;
+    }
+
+    /**
+     * Split a path or URL into a list of segments, excluding the leading and trailing slashes.
+     *
+     * @param string $path
+     * @return Vector<string>
+     */
+    protected function _splitPath(string $path): Vector<string> {
+        $path = trim($path, '/');
+
+        if ($path === '') {
+            return Vector {};
+        }
+
+        return new Vector(explode('/', $path));
+    }
+
+}
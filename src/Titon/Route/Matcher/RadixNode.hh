@@ -0,0 +1,117 @@
+<?hh // strict
+/**
+ * @copyright   2010-2015, The Titon Project
+ * @license     http://opensource.org/licenses/bsd-license.php
+ * @link        http://titon.io
+ */
+
+namespace Titon\Route\Matcher;
+
+type RadixNodeMap = Map<string, RadixNode>;
+type RouteIndexList = Vector<int>;
+
+/**
+ * A single node within the radix tree built by the RadixMatcher. Each node represents a static path segment
+ * and holds the indices of the routes that either end at this segment, or continue with tokenized segments.
+ *
+ * @package Titon\Route\Matcher
+ */
+class RadixNode {
+
+    /**
+     * Child nodes keyed by their lowercased static segment.
+     *
+     * @var \Titon\Route\Matcher\RadixNodeMap
+     */
+    protected RadixNodeMap $_children = Map {};
+
+    /**
+     * Indices of routes that continue with tokenized segments after this node.
+     *
+     * @var \Titon\Route\Matcher\RouteIndexList
+     */
+    protected RouteIndexList $_dynamic = Vector {};
+
+    /**
+     * Indices of fully static routes that end at this node.
+     *
+     * @var \Titon\Route\Matcher\RouteIndexList
+     */
+    protected RouteIndexList $_static = Vector {};
+
+    /**
+     * Add a route index that requires regex matching from this node onward.
+     *
+     * @param int $index
+     * @return $this
+     */
+    public function addDynamic(int $index): this {
+        $this->_dynamic[] = $index;
+
+        return $this;
+    }
+
+    /**
+     * Add a route index for a static route ending at this node.
+     *
+     * @param int $index
+     * @return $this
+     */
+    public function addStatic(int $index): this {
+        $this->_static[] = $index;
+
+        return $this;
+    }
+
+    /**
+     * Return a child node by segment, or null if it does not exist.
+     *
+     * @param string $segment
+     * @return \Titon\Route\Matcher\RadixNode
+     */
+    public function getChild(string $segment): ?RadixNode {
+        return $this->_children->get($segment);
+    }
+
+    /**
+     * Return all child nodes.
+     *
+     * @return \Titon\Route\Matcher\RadixNodeMap
+     */
+    public function getChildren(): RadixNodeMap {
+        return $this->_children;
+    }
+
+    /**
+     * Return the indices of tokenized routes.
+     *
+     * @return \Titon\Route\Matcher\RouteIndexList
+     */
+    public function getDynamic(): RouteIndexList {
+        return $this->_dynamic;
+    }
+
+    /**
+     * Return the indices of static routes.
+     *
+     * @return \Titon\Route\Matcher\RouteIndexList
+     */
+    public function getStatic(): RouteIndexList {
+        return $this->_static;
+    }
+
+    /**
+     * Return a child node by segment, creating it if it does not exist.
+     *
+     * @param string $segment
+     * @return \Titon\Route\Matcher\RadixNode
+     */
+    public function makeChild(string $segment): RadixNode {
+        if (!$this->_children->contains($segment)) {
+            $this->_children[$segment] = new RadixNode();
+        }
+
+        return $this->_children[$segment];
+    }
+
+}
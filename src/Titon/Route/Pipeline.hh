@@ -0,0 +1,173 @@
+<?hh // strict
+/**
+ * @copyright   2010-2015, The Titon Project
+ * @license     http://opensource.org/licenses/bsd-license.php
+ * @link        http://titon.io
+ */
+
+namespace Titon\Route;
+
+type PipelineStage = shape('callback' => ?FilterCallback, 'async' => Vector<AsyncFilterCallback>);
+type PipelineStageList = Vector<PipelineStage>;
+
+/**
+ * The Pipeline is a resolved chain of filters that is run for a matched route.
+ * Filters are run in order, and the first filter to return a non-null value will short-circuit the chain.
+ * Consecutive async filters are grouped into a single stage and awaited concurrently.
+ *
+ * @package Titon\Route
+ */
+class Pipeline {
+
+    /**
+     * Does the pipeline contain async filters?
+     *
+     * @var bool
+     */
+    protected bool $_async = false;
+
+    /**
+     * The number of filters in the pipeline.
+     *
+     * @var int
+     */
+    protected int $_count = 0;
+
+    /**
+     * Stages of filters to run in order.
+     *
+     * @var \Titon\Route\PipelineStageList
+     */
+    protected PipelineStageList $_stages = Vector {};
+
+    /**
+     * Add a filter as its own stage.
+     *
+     * @param \Titon\Route\FilterCallback $callback
+     * @return $this
+     */
+    public function add(FilterCallback $callback): this {
+        $this->_stages[] = shape(
+            'callback' => $callback,
+            'async' => Vector {}
+        );
+
+        $this->_count++;
+
+        return $this;
+    }
+
+    /**
+     * Add an async filter. If the previous stage contains async filters, the filter will be awaited concurrently with them.
+     *
+     * @param \Titon\Route\AsyncFilterCallback $callback
+     * @return $this
+     */
+    public function addAsync(AsyncFilterCallback $callback): this {
+        $last = count($this->_stages) - 1;
+
+        if ($last >= 0 && $this->_stages[$last]['callback'] === null) {
+            $this->_stages[$last]['async'][] = $callback;
+        } else {
+            $this->_stages[] = shape(
+                'callback' => null,
+                'async' => Vector {$callback}
+            );
+        }
+
+        $this->_async = true;
+        $this->_count++;
+
+        return $this;
+    }
+
+    /**
+     * Return the number of filters in the pipeline.
+     *
+     * @return int
+     */
+    public function count(): int {
+        return $this->_count;
+    }
+
+    /**
+     * Return the stages of the pipeline.
+     *
+     * @return \Titon\Route\PipelineStageList
+     */
+    public function getStages(): PipelineStageList {
+        return $this->_stages;
+    }
+
+    /**
+     * Return true if the pipeline contains async filters.
+     *
+     * @return bool
+     */
+    public function isAsync(): bool {
+        return $this->_async;
+    }
+
+    /**
+     * Run all filters and return the response of the filter that short-circuited the chain, or null.
+     * Pipelines without async filters are run without any wait handles.
+     *
+     * @param \Titon\Route\Router $router
+     * @param \Titon\Route\Route $route
+     * @return mixed
+     */
+    public function run(Router $router, Route $route): mixed {
+        if ($this->isAsync()) {
+            return $this->runAsync($router, $route)->getWaitHandle()->join();
+        }
+
+        foreach ($this->_stages as $stage) {
+            $callback = $stage['callback'];
+
+            if ($callback !== null && ($response = $callback($router, $route)) !== null) {
+                return $response;
+            }
+        }
+
+        return null;
+    }
+
+    /**
+     * Run all filters asynchronously and return the response of the filter that short-circuited the chain, or null.
+     * If multiple async filters in the same stage return a response, the first one in the chain is used.
+     *
+     * @param \Titon\Route\Router $router
+     * @param \Titon\Route\Route $route
+     * @return Awaitable<mixed>
+     */
+    public async function runAsync(Router $router, Route $route): Awaitable<mixed> {
+        foreach ($this->_stages as $stage) {
+            $callback = $stage['callback'];
+
+            if ($callback !== null) {
+                $response = $callback($router, $route);
+
+                if ($response !== null) {
+                    return $response;
+                }
+
+                continue;
+            }
+
+            $handles = Vector {};
+
+            foreach ($stage['async'] as $asyncCallback) {
+                $handles[] = $asyncCallback($router, $route)->getWaitHandle();
+            }
+
+            foreach (await GenVectorWaitHandle::create($handles) as $response) {
+                if ($response !== null) {
+                    return $response;
+                }
+            }
+        }
+
+        return null;
+    }
+
+}
@@ -10,6 +10,7 @@ namespace Titon\Route;
 use Titon\Common\ArgumentList;
 use Titon\Route\Exception\MissingPatternException;
 use Titon\Route\Exception\NoMatchException;
+use Titon\Route\Exception\UncompilableRouteException;
 use Titon\Route\Mixin\ConditionMixin;
 use Titon\Route\Mixin\FilterMixin;
 use Titon\Route\Mixin\MethodMixin;
@@ -21,8 +22,20 @@ use \ReflectionFunctionAbstract;
 use \ReflectionMethod;
 use \Serializable;
 
+type CompiledRoute = shape(
+    'class' => string,
+    'path' => string,
+    'action' => Action,
+    'compiled' => string,
+    'static' => bool,
+    'tokens' => array<Token>,
+    'methods' => array<string>,
+    'filters' => array<string>,
+    'patterns' => array<string, string>,
+    'secure' => bool
+);
 type ParamMap = Map<string, mixed>;
-type Token = shape('token' => string, 'optional' => bool);
+type Token = shape('token' => string, 'optional' => bool, 'type' => string, 'group' => int);
 type TokenList = Vector<Token>;
 
 /**
@@ -43,6 +56,12 @@ class Route implements Serializable {
     const string WILDCARD = '([^\/]+)';
     const string LOCALE = '([a-z]{2}(?:-[a-z]{2})?)';
 
+    /**
+     * Types of token values. Numeric values are cast when matched, if casting does not lose data.
+     */
+    const string TYPE_NUMERIC = 'numeric';
+    const string TYPE_STRING = 'string';
+
     /**
      * The action to execute if this route is matched.
      *
@@ -50,6 +69,13 @@ class Route implements Serializable {
      */
     protected Action $_action;
 
+    /**
+     * Tokens keyed by the position of their capture group. Only the first occurrence of a token is included.
+     *
+     * @var Map<int, \Titon\Route\Token>
+     */
+    protected Map<int, Token> $_captures = Map {};
+
     /**
      * The compiled regex pattern.
      *
@@ -57,6 +83,13 @@ class Route implements Serializable {
      */
     protected string $_compiled = '';
 
+    /**
+     * The response returned by a filter that short-circuited the route.
+     *
+     * @var mixed
+     */
+    protected mixed $_filterResponse = null;
+
     /**
      * Collection of route parameters.
      *
@@ -135,22 +168,28 @@ class Route implements Serializable {
         if (!$this->isStatic()) {
             $tokens = [];
             $matches = [];
+            $names = Set {};
+            $group = 1;
 
             // Match regex pattern tokens first
-            preg_match_all('/(\<)([^\<\>]+)(\>)/i', $path, $matches, PREG_SET_ORDER);
+            preg_match_all('/(\<)([^\<\>]+)(\>)/i', $path, $matches, PREG_SET_ORDER | PREG_OFFSET_CAPTURE);
             $tokens = array_merge($tokens, $matches);
 
             // Then match regular tokens
-            preg_match_all('/(\{|\(|\[)([a-z0-9\?]+)(\}|\)|\])/i', $path, $matches, PREG_SET_ORDER);
+            preg_match_all('/(\{|\(|\[)([a-z0-9\?]+)(\}|\)|\])/i', $path, $matches, PREG_SET_ORDER | PREG_OFFSET_CAPTURE);
             $tokens = array_merge($tokens, $matches);
 
             if ($tokens) {
+                // Order by position so that the tokens line up with the capture groups
+                usort($tokens, ($a, $b) ==> $a[0][1] - $b[0][1]);
+
                 foreach ($tokens as $match) {
-                    $chunk = $match[0];
-                    $open = array_key_exists(1, $match) ? $match[1] : ''; // opening brace
-                    $token = array_key_exists(2, $match) ? $match[2] : ''; // token
-                    $close = array_key_exists(3, $match) ? $match[3] : ''; // closing brace
+                    $chunk = $match[0][0];
+                    $open = $match[1][0]; // opening brace
+                    $token = $match[2][0]; // token
+                    $close = $match[3][0]; // closing brace
                     $optional = false;
+                    $type = self::TYPE_STRING;
 
                     // Is the token optional
                     if (substr($token, -1) === '?') {
@@ -171,27 +210,45 @@ class Route implements Serializable {
 
                     } else if ($open === '[' && $close === ']') {
                         $pattern = self::NUMERIC;
+                        $type = self::TYPE_NUMERIC;
 
                     } else if ($open === '(' && $close === ')') {
                         $pattern = self::WILDCARD;
 
                     } else if ($open === '<' && $close === '>' && $patterns->contains($token)) {
                         $pattern = '(' . trim($patterns[$token], '()') . ')';
+                        $type = $this->_getPatternType($pattern);
 
                     } else {
                         throw new MissingPatternException(sprintf('Unknown pattern for %s token', $token));
                     }
 
+                    // Name the capture group so that values can be extracted by token,
+                    // unless the token is not a valid group name or has already been used
+                    if (static::_isGroupName($token) && !$names->contains($token)) {
+                        $pattern = '(?P<' . $token . '>' . substr($pattern, 1);
+                        $names[] = $token;
+                    }
+
                     // Apply optional flag by altering chunk and pattern
                     if ($optional) {
                         $chunk = '\/' . $chunk;
                         $pattern = '(?:\/' . $pattern . ')?';
                     }
 
-                    $compiled = str_replace($chunk, $pattern, $compiled);
+                    // Only replace the first occurrence, as the same token can be used more than once
+                    $pos = strpos($compiled, $chunk);
 
-                    $this->_tokens[] = shape('token' => $token, 'optional' => $optional);
+                    if ($pos !== false) {
+                        $compiled = substr_replace($compiled, $pattern, $pos, strlen($chunk));
+                    }
+
+                    $this->_tokens[] = shape('token' => $token, 'optional' => $optional, 'type' => $type, 'group' => $group);
+
+                    $group += static::_countGroups($pattern);
                 }
+
+                $this->_buildCaptures();
             } else {
                 $this->setStatic(true);
             }
@@ -210,6 +267,7 @@ class Route implements Serializable {
      * Dispatch the current route to the defined action only if the route has been matched.
      * The dispatcher will use the params gathered from the token list to pass as arguments to the action.
      * Arguments will take into account default values defined on the method.
+     * If a filter short-circuited the route, its response is returned and the action is not called.
      *
      * @return mixed - The response of the action call
      * @exception \Titon\Route\Exception\NoMatchException
@@ -219,6 +277,10 @@ class Route implements Serializable {
             throw new NoMatchException('Route cannot be dispatched unless it has been matched');
         }
 
+        if ($this->_filterResponse !== null) {
+            return $this->_filterResponse;
+        }
+
         $action = $this->getAction();
         $object = Registry::factory($action['class']);
         $method = new ReflectionMethod($object, $action['action']);
@@ -226,6 +288,39 @@ class Route implements Serializable {
         return $method->invokeArgs($object, $this->getActionArguments()->toArray());
     }
 
+    /**
+     * Compile the route and export it as a shape of scalar values, which can be written to a generated file
+     * and turned back into a route with `import()`. Routes with conditions cannot be exported, nor can routes
+     * whose class has a custom constructor but does not override `import()`.
+     *
+     * @return \Titon\Route\CompiledRoute
+     * @throws \Titon\Route\Exception\UncompilableRouteException
+     */
+    public function export(): CompiledRoute {
+        if ($this->getConditions()) {
+            throw new UncompilableRouteException(sprintf('Route %s has conditions and cannot be exported', $this->getPath()));
+        }
+
+        if (!static::_isImportable()) {
+            throw new UncompilableRouteException(sprintf('Route class %s has a custom constructor and must override import() to be exported', static::class));
+        }
+
+        $compiled = $this->compile();
+
+        return shape(
+            'class' => static::class,
+            'path' => $this->getPath(),
+            'action' => $this->getAction(),
+            'compiled' => $compiled,
+            'static' => $this->getStatic(),
+            'tokens' => $this->getTokens()->toArray(),
+            'methods' => $this->getMethods()->toArray(),
+            'filters' => $this->getFilters()->toArray(),
+            'patterns' => $this->getPatterns()->toArray(),
+            'secure' => $this->getSecure()
+        );
+    }
+
     /**
      * Return the action to dispatch to.
      *
@@ -247,6 +342,15 @@ class Route implements Serializable {
         return $this->_getArguments($method);
     }
 
+    /**
+     * Return the response returned by a filter that short-circuited the route, or null.
+     *
+     * @return mixed
+     */
+    public function getFilterResponse(): mixed {
+        return $this->_filterResponse;
+    }
+
     /**
      * Return the custom path.
      *
@@ -293,6 +397,41 @@ class Route implements Serializable {
         return $this->_tokens;
     }
 
+    /**
+     * Create a route from a previously exported shape. The route will not need to be compiled again.
+     * The route class defined in the shape is asked to import itself, so route classes with a custom
+     * constructor can override this method.
+     *
+     * @param \Titon\Route\CompiledRoute $data
+     * @return \Titon\Route\Route
+     */
+    public static function import(CompiledRoute $data): Route {
+        $class = $data['class'];
+
+        if ($class !== static::class) {
+            // UNSAFE
+            // Since the route class is defined in the exported data
+            return $class::import($data);
+        }
+
+        // UNSAFE
+        // Since the constructor signature is verified when exporting
+        $route = new static($data['path'], Router::buildAction($data['action']));
+
+        invariant($route instanceof Route, 'Must be a Route');
+
+        $route->_compiled = $data['compiled'];
+        $route->_tokens = new Vector($data['tokens']);
+        $route->_buildCaptures();
+
+        return $route
+            ->setStatic($data['static'])
+            ->setMethods(new Vector($data['methods']))
+            ->setFilters(new Vector($data['filters']))
+            ->setPatterns(new Map($data['patterns']))
+            ->setSecure($data['secure']);
+    }
+
     /**
      * Has the regex pattern been compiled?
      *
@@ -368,13 +507,22 @@ class Route implements Serializable {
      * @return bool
      */
     public function isSecure(): bool {
-        if ($this->getSecure() && !(Server::get('HTTPS') === 'on' || Server::get('SERVER_PORT') === '443')) {
+        if ($this->getSecure() && !static::isSecureRequest()) {
             return false; // Only validate if the secure flag is true
         }
 
         return true;
     }
 
+    /**
+     * Is the current request made over a secure connection, either through HTTPS or port 443?
+     *
+     * @return bool
+     */
+    public static function isSecureRequest(): bool {
+        return (Server::get('HTTPS') === 'on' || (string) Server::get('SERVER_PORT') === '443');
+    }
+
     /**
      * Is the route static (no regex patterns)?
      *
@@ -401,19 +549,30 @@ class Route implements Serializable {
 
     /**
      * Receive a list of matched values and apply it to the current route.
-     * These matches will equate to tokens, arguments, and other required values.
+     * Values are mapped to tokens by the position of their capture group, which was determined when compiling,
+     * so named captures and lists without them, like those from a combined pattern, are handled the same.
+     * Optional tokens that were not matched are set to an empty string.
      *
-     * @param array<string> $matches
+     * @param array<arraykey, string> $matches
      * @return $this
      */
-    public function match(array<string> $matches): this {
-        $tokens = $this->getTokens();
+    public function match(array<arraykey, string> $matches): this {
+        $this->_url = (string) $matches[0];
+        $this->_params = Map {};
+        $this->_filterResponse = null;
 
-        $this->_url = array_shift($matches);
+        foreach ($matches as $group => $value) {
+            if (is_int($group) && ($token = $this->_captures->get($group)) !== null) {
+                $this->_params[$token['token']] = $this->_castParam($token, $value);
+            }
+        }
 
-        if ($matches && $tokens) {
-            foreach ($tokens as $token) {
-                $this->_params[$token['token']] = array_shift($matches);
+        // Trailing optional tokens that were not matched are not captured
+        if (count($this->_params) < count($this->_captures)) {
+            foreach ($this->_captures as $token) {
+                if (!$this->_params->contains($token['token'])) {
+                    $this->_params[$token['token']] = '';
+                }
             }
         }
 
@@ -432,6 +591,22 @@ class Route implements Serializable {
         return $this;
     }
 
+    /**
+     * Restore the matched URL and params from a previous match, without matching the URL again.
+     * The params are expected to be already type cast, as returned by `getParams()`.
+     *
+     * @param string $url
+     * @param \Titon\Route\ParamMap $params
+     * @return $this
+     */
+    public function restore(string $url, ParamMap $params): this {
+        $this->_url = $url;
+        $this->_params = $params->toMap();
+        $this->_filterResponse = null;
+
+        return $this;
+    }
+
     /**
      * Serialize the compiled route for increasing performance when caching mapped routes.
      */
@@ -461,6 +636,18 @@ class Route implements Serializable {
         return $this;
     }
 
+    /**
+     * Set the response of a filter that short-circuited the route.
+     *
+     * @param mixed $response
+     * @return $this
+     */
+    public function setFilterResponse(mixed $response): this {
+        $this->_filterResponse = $response;
+
+        return $this;
+    }
+
     /**
      * Set the static flag.
      *
@@ -485,6 +672,7 @@ class Route implements Serializable {
         $this->_action = $data['action'];
         $this->_tokens = $data['tokens'];
         $this->_compiled = $data['compiled'];
+        $this->_buildCaptures();
 
         $this->setFilters($data['filters']);
         $this->setMethods($data['methods']);
@@ -502,6 +690,60 @@ class Route implements Serializable {
         return $this->_url;
     }
 
+    /**
+     * Map the tokens by the position of their capture group, so that matches can be applied in a single pass.
+     */
+    protected function _buildCaptures(): void {
+        $captures = Map {};
+        $names = Set {};
+
+        foreach ($this->_tokens as $token) {
+            if (!$names->contains($token['token'])) {
+                $captures[$token['group']] = $token;
+                $names[] = $token['token'];
+            }
+        }
+
+        $this->_captures = $captures;
+    }
+
+    /**
+     * Cast a matched value based on the type of its token. Numeric values are cast to an integer or float,
+     * but only if the value is unchanged when cast back, so that values like `007` or `1.50` remain strings.
+     *
+     * @param \Titon\Route\Token $token
+     * @param string $value
+     * @return mixed
+     */
+    protected function _castParam(Token $token, string $value): mixed {
+        if ($token['type'] !== self::TYPE_NUMERIC) {
+            return $value;
+        }
+
+        if ((string) (int) $value === $value) {
+            return (int) $value;
+        }
+
+        if (is_numeric($value) && (string) (float) $value === $value) {
+            return (float) $value;
+        }
+
+        return $value;
+    }
+
+    /**
+     * Return the number of capture groups within a regex pattern.
+     *
+     * @param string $regex
+     * @return int
+     */
+    protected static function _countGroups(string $regex): int {
+        $regex = preg_replace('/\\\\./', '', $regex); // Escaped characters
+        $regex = preg_replace('/\[[^\]]*\]/', '', $regex); // Character classes
+
+        return preg_match_all('/\((?!\?)|\(\?P?<[a-z_]/i', $regex);
+    }
+
     /**
      * Gather a list of arguments to pass to the dispatcher based on the tokens and params from the route.
      * Furthermore, loop through and set any default values using reflection, and type cast appropriately.
@@ -511,14 +753,17 @@ class Route implements Serializable {
      */
     protected function _getArguments(ReflectionFunctionAbstract $method): ArgumentList {
         $tokens = $this->getTokens();
-        $args = $this->getParams()->values();
+        $params = $this->getParams();
+        $args = Vector {};
 
         foreach ($method->getParameters() as $i => $param) {
             if (!$tokens->containsKey($i)) {
                 continue;
             }
 
-            if ($tokens[$i]['optional'] && (!array_key_exists($i, $args) || $args[$i] === '' || $args[$i] === null)) {
+            $args[$i] = $params->get($tokens[$i]['token']);
+
+            if ($tokens[$i]['optional'] && ($args[$i] === '' || $args[$i] === null)) {
                 $args[$i] = $param->getDefaultValue();
             }
 
@@ -533,4 +778,60 @@ class Route implements Serializable {
         return $args;
     }
 
+    /**
+     * Determine the type of a custom pattern. Patterns that only match digits are numeric.
+     *
+     * @param string $pattern
+     * @return string
+     */
+    protected function _getPatternType(string $pattern): string {
+        if (preg_match('/^\((?:\[0-9\]|\[0-9\\\\\.\]|\\\\d)(?:[\+\*]|\{\d+(?:,\d*)?\})?\)$/', $pattern)) {
+            return self::TYPE_NUMERIC;
+        }
+
+        return self::TYPE_STRING;
+    }
+
+    /**
+     * Return true if the token can be used as the name of a capture group. PCRE requires
+     * names to start with a letter or underscore, and to be at most 32 characters.
+     *
+     * @param string $token
+     * @return bool
+     */
+    protected static function _isGroupName(string $token): bool {
+        return (bool) preg_match('/^[a-z_][a-z0-9_]{0,31}$/i', $token);
+    }
+
+    /**
+     * Return true if the route class can be created by the base `import()`, either because its constructor
+     * accepts a path and action like the base class, or because it overrides `import()`.
+     *
+     * @return bool
+     */
+    protected static function _isImportable(): bool {
+        $import = new ReflectionMethod(static::class, 'import');
+
+        if ($import->getDeclaringClass()->getName() !== Route::class) {
+            return true;
+        }
+
+        $params = (new ReflectionMethod(static::class, '__construct'))->getParameters();
+
+        if (count($params) < 2) {
+            return false;
+        }
+
+        foreach ($params as $i => $param) {
+            if ($i < 2 && !in_array($param->getTypehintText(), ['string', 'HH\string', ''])) {
+                return false;
+
+            } else if ($i >= 2 && !$param->isOptional()) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
 }
@@ -25,9 +25,17 @@ trait RouteAnnotation {
      * The following format is supported. Both the methods and filters can be a string, or an array of strings.
      *
      *      <<Route($path[, $methods[, $filters]])>>
+     *
+     * If the routes have already been loaded from a cache or a compiled dispatch table,
+     * they will include the annotated routes, so the reflection is skipped.
      */
     private function __wireRouteAnnotations(): void {
         $router = Router::registry();
+
+        if ($router->isCached()) {
+            return;
+        }
+
         $class = static::class;
         $key = strtolower(Path::className($class));
 
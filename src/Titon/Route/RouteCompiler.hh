@@ -0,0 +1,90 @@
+<?hh // strict
+/**
+ * @copyright   2010-2015, The Titon Project
+ * @license     http://opensource.org/licenses/bsd-license.php
+ * @link        http://titon.io
+ */
+
+namespace Titon\Route;
+
+use Titon\Io\File;
+
+type CompiledRouteMap = array<string, CompiledRoute>;
+
+/**
+ * The RouteCompiler exports all routes mapped in a Router into a generated Hack file containing a static dispatch table.
+ * The file can then be loaded with `Router::loadCompiled()`, which avoids unserializing a route cache,
+ * and the reflection required to wire route annotations, on every request.
+ *
+ * {{{
+ *      (new RouteCompiler(Router::registry()))->write('/path/to/routes.hh');
+ * }}}
+ *
+ * @package Titon\Route
+ */
+class RouteCompiler {
+
+    /**
+     * Router instance.
+     *
+     * @var \Titon\Route\Router
+     */
+    protected Router $_router;
+
+    /**
+     * Store the Router instance.
+     *
+     * @param \Titon\Route\Router $router
+     */
+    public function __construct(Router $router) {
+        $this->_router = $router;
+    }
+
+    /**
+     * Compile and export every mapped route, in the order they were mapped.
+     *
+     * @return \Titon\Route\CompiledRouteMap
+     * @throws \Titon\Route\Exception\UncompilableRouteException
+     */
+    public function compile(): CompiledRouteMap {
+        $routes = [];
+
+        foreach ($this->getRouter()->getRoutes() as $key => $route) {
+            $routes[$key] = $route->export();
+        }
+
+        return $routes;
+    }
+
+    /**
+     * Generate the source of the dispatch table file.
+     *
+     * @return string
+     */
+    public function generate(): string {
+        return sprintf("<?hh\n/**\n * Generated by %s on %s. Do not edit this file manually.\n */\n\nreturn %s;\n",
+            static::class,
+            date('Y-m-d H:i:s'),
+            var_export($this->compile(), true));
+    }
+
+    /**
+     * Return the Router instance.
+     *
+     * @return \Titon\Route\Router
+     */
+    public function getRouter(): Router {
+        return $this->_router;
+    }
+
+    /**
+     * Generate the dispatch table and write it to the file system.
+     *
+     * @param string $path
+     * @return bool
+     */
+    public function write(string $path): bool {
+        return (new File($path, true))->write($this->generate());
+    }
+
+}
@@ -26,12 +26,17 @@ use Titon\Utility\State\Get;
 use Titon\Utility\State\Server;
 
 type Action = shape('class' => string, 'action' => string);
-type FilterCallback = (function(Router, Route): void);
+type AsyncFilterCallback = (function(Router, Route): Awaitable<mixed>);
+type AsyncFilterMap = Map<string, AsyncFilterCallback>;
+type FilterCallback = (function(Router, Route): mixed);
 type FilterMap = Map<string, FilterCallback>;
 type GroupCallback = (function(Router, Group): void);
 type GroupList = Vector<RouteGroup>;
+type PartitionMap = Map<string, string>;
+type PipelineMap = Map<string, Pipeline>;
 type QueryMap = Map<string, mixed>;
 type ResourceMap = Map<string, string>;
+type RouteIndex = Map<string, RouteMap>;
 type RouteMap = Map<string, Route>;
 type SegmentMap = Map<string, mixed>;
 
@@ -47,6 +52,13 @@ type SegmentMap = Map<string, mixed>;
 class Router implements Subject {
     use Emittable, FactoryAware;
 
+    /**
+     * List of async filters to trigger for specific routes during a match.
+     *
+     * @var \Titon\Route\AsyncFilterMap
+     */
+    protected AsyncFilterMap $_asyncFilters = Map {};
+
     /**
      * Base folder structure if the application was placed within a directory.
      *
@@ -68,6 +80,13 @@ class Router implements Subject {
      */
     protected ?Route $_current;
 
+    /**
+     * A hash of the route table, used to invalidate match results.
+     *
+     * @var string
+     */
+    protected ?string $_fingerprint;
+
     /**
      * List of filters to trigger for specific routes during a match.
      *
@@ -75,6 +94,27 @@ class Router implements Subject {
      */
     protected FilterMap $_filters = Map {};
 
+    /**
+     * The response returned by a filter that short-circuited the matched route.
+     *
+     * @var mixed
+     */
+    protected mixed $_filterResponse = null;
+
+    /**
+     * The position of the first route with conditions that was mapped, or -1 if there are none.
+     *
+     * @var int
+     */
+    protected int $_firstConditional = -1;
+
+    /**
+     * The position of the first tokenized route that was mapped, or -1 if there are none.
+     *
+     * @var int
+     */
+    protected int $_firstTokenized = -1;
+
     /**
      * List of currently open groups (and their options) in the stack.
      *
@@ -82,6 +122,27 @@ class Router implements Subject {
      */
     protected GroupList $_groups = Vector {};
 
+    /**
+     * Have the static path and HTTP method indices been built from the current routes?
+     *
+     * @var bool
+     */
+    protected bool $_indexed = false;
+
+    /**
+     * Route keys keyed by the object hash of the route, used to find the key of a matched route.
+     *
+     * @var Map<string, string>
+     */
+    protected Map<string, string> $_keys = Map {};
+
+    /**
+     * Cache of previously matched URLs.
+     *
+     * @var \Titon\Route\MatchCache
+     */
+    protected ?MatchCache $_matchCache;
+
     /**
      * The class to use for route matching.
      *
@@ -109,6 +170,43 @@ class Router implements Subject {
         'delete' => 'delete'
     };
 
+    /**
+     * Tokenized routes grouped by HTTP method, in the order they were mapped.
+     * Routes without a method restriction are placed in every group, and in the `*` group.
+     *
+     * @var \Titon\Route\RouteIndex
+     */
+    protected RouteIndex $_methodRoutes = Map {};
+
+    /**
+     * Resolved filter pipelines, keyed by the route's filter chain.
+     *
+     * @var \Titon\Route\PipelineMap
+     */
+    protected PipelineMap $_pipelines = Map {};
+
+    /**
+     * Route keys mapped to the cache partition they are stored in, in the order they were mapped.
+     * Only populated when routes have been loaded from the cache.
+     *
+     * @var \Titon\Route\PartitionMap
+     */
+    protected PartitionMap $_partitions = Map {};
+
+    /**
+     * Cache partitions that have been hydrated into the route list.
+     *
+     * @var Set<string>
+     */
+    protected Set<string> $_partitionsLoaded = Set {};
+
+    /**
+     * The position each route was mapped in, keyed by route key.
+     *
+     * @var Map<string, int>
+     */
+    protected Map<string, int> $_positions = Map {};
+
     /**
      * Manually defined aesthetic routes that re-route internally.
      *
@@ -123,6 +221,13 @@ class Router implements Subject {
      */
     protected SegmentMap $_segments = Map {};
 
+    /**
+     * Routes that contain no tokens, keyed by their lowercased path.
+     *
+     * @var \Titon\Route\RouteIndex
+     */
+    protected RouteIndex $_staticRoutes = Map {};
+
     /**
      * Storage engine instance.
      *
@@ -154,7 +259,6 @@ class Router implements Subject {
         // Set caching events
         $this->on('route.matching', inst_meth($this, 'doLoadRoutes'), 1);
         $this->on('route.matched', inst_meth($this, 'doCacheRoutes'), 1);
-        $this->on('route.matched', inst_meth($this, 'doRunFilters'), 2);
     }
 
     /**
@@ -217,26 +321,33 @@ class Router implements Subject {
         }
 
         if (($storage = $this->getStorage()) && ($routes = $this->getRoutes())) {
+            $index = Map {};
+            $partitions = Map {};
+
             // Before caching, make sure all routes are compiled
-            foreach ($routes as $route) {
+            foreach ($routes as $key => $route) {
                 $route->compile();
+
+                $partition = $this->_getRoutePartition($route);
+
+                if (!$partitions->contains($partition)) {
+                    $partitions[$partition] = Map {};
+                }
+
+                $partitions[$partition][$key] = $route;
+                $index[$key] = $partition;
             }
 
             // Compiling before hand should speed up the next request
-            $storage->save(new Item('routes', serialize($routes), '+1 year'));
-        }
-    }
+            foreach ($partitions as $partition => $partitionRoutes) {
+                $storage->save(new Item($this->_getPartitionKey($partition), serialize($partitionRoutes), '+1 year'));
+            }
 
-    /**
-     * Loop through and execute for every filter defined in the matched route.
-     *
-     * @param \Titon\Event\Event $event
-     * @param \Titon\Route\Router $router
-     * @param \Titon\Route\Route $route
-     */
-    public function doRunFilters(Event $event, Router $router, Route $route): void {
-        foreach ($route->getFilters() as $filter) {
-            call_user_func_array($this->getFilter($filter), [$router, $route]);
+            // Save the index last, so that it never points to missing partitions
+            $storage->save(new Item('routes', serialize(Map {
+                'fingerprint' => $this->getFingerprint(),
+                'partitions' => $index
+            }), '+1 year'));
         }
     }
 
@@ -244,19 +355,64 @@ class Router implements Subject {
      * Load routes from the cache if they exist.
      * This method is automatically called during the `matching` event.
      *
+     * Routes are cached in partitions based on their first path segment, so only the partition
+     * that can match the URL, and the partition of routes that start with a token, are loaded.
+     * Other partitions are loaded on demand when a route is requested by key.
+     *
      * @param \Titon\Event\Event $event
      * @param \Titon\Route\Router $router
      * @param string $url
      */
     public function doLoadRoutes(Event $event, Router $router, string $url): void {
+        $partitions = Set {'*', $this->_getUrlPartition($url)};
+
+        if ($this->isCached()) {
+            $this->_loadPartitions($partitions);
+
+            return;
+        }
+
         $item = $this->getStorage()?->getItem('routes');
 
-        if ($item !== null && $item->isHit()) {
-            $this->_routes = unserialize($item->get());
+        if ($item === null || !$item->isHit()) {
+            return;
+        }
+
+        $routes = $this->_routes;
+        $index = unserialize($item->get());
+
+        $this->_partitions = $index['partitions'];
+        $this->_partitionsLoaded = Set {};
+        $this->_routes = Map {};
+        $this->_indexed = false;
+
+        if ($this->_loadPartitions($partitions)) {
             $this->_cached = true;
+            $this->_fingerprint = $index['fingerprint'];
+
+        // A partition has expired, so fall back to the mapped routes
+        } else {
+            $this->_partitions = Map {};
+            $this->_routes = $routes;
+            $this->_indexed = false;
         }
     }
 
+    /**
+     * Run the filter pipeline of a route. This method is automatically called by `match()`
+     * after the `matched` event, outside of the event dispatch.
+     *
+     * If a filter short-circuits the pipeline, its response is set on the route, so that `Route::dispatch()`
+     * returns it instead of calling the action.
+     *
+     * @param \Titon\Event\Event $event
+     * @param \Titon\Route\Router $router
+     * @param \Titon\Route\Route $route
+     */
+    public function doRunFilters(Event $event, Router $router, Route $route): void {
+        $this->_runFilters($route);
+    }
+
     /**
      * Map a filter object to be triggered when a route is matched.
      *
@@ -265,7 +421,31 @@ class Router implements Subject {
      * @return $this
      */
     public function filter(string $key, Filter $callback): this {
-        $this->_filters[$key] = inst_meth($callback, 'filter');
+        return $this->filterCallback($key, inst_meth($callback, 'filter'));
+    }
+
+    /**
+     * Map an async filter object to be triggered when a route is matched.
+     *
+     * @param string $key
+     * @param \Titon\Route\AsyncFilter $callback
+     * @return $this
+     */
+    public function filterAsync(string $key, AsyncFilter $callback): this {
+        return $this->filterAsyncCallback($key, inst_meth($callback, 'filter'));
+    }
+
+    /**
+     * Map an async filter callback to be triggered when a route is matched.
+     *
+     * @param string $key
+     * @param \Titon\Route\AsyncFilterCallback $callback
+     * @return $this
+     */
+    public function filterAsyncCallback(string $key, AsyncFilterCallback $callback): this {
+        $this->_asyncFilters[$key] = $callback;
+        $this->_filters->remove($key);
+        $this->_pipelines->clear();
 
         return $this;
     }
@@ -279,6 +459,8 @@ class Router implements Subject {
      */
     public function filterCallback(string $key, FilterCallback $callback): this {
         $this->_filters[$key] = $callback;
+        $this->_asyncFilters->remove($key);
+        $this->_pipelines->clear();
 
         return $this;
     }
@@ -294,6 +476,34 @@ class Router implements Subject {
         return $this->http($key, Vector {'get'}, $route);
     }
 
+    /**
+     * Return a hash of the route table, which changes whenever a route is mapped or changed.
+     * When routes are loaded from the cache, the fingerprint of the cached routes is used.
+     *
+     * @return string
+     */
+    public function getFingerprint(): string {
+        if ($this->_fingerprint !== null) {
+            return $this->_fingerprint;
+        }
+
+        $hash = '';
+
+        foreach ($this->getRoutes() as $key => $route) {
+            $hash .= implode('|', [
+                $key,
+                get_class($route),
+                $route->getPath(),
+                implode(',', $route->getMethods()),
+                http_build_query($route->getPatterns()->toArray()),
+                (int) $route->getSecure(),
+                (int) $route->getStatic()
+            ]) . "\n";
+        }
+
+        return $this->_fingerprint = md5($hash);
+    }
+
     /**
      * Return a filter by key.
      *
@@ -309,6 +519,15 @@ class Router implements Subject {
         throw new MissingFilterException(sprintf('Filter %s does not exist', $key));
     }
 
+    /**
+     * Return the response returned by a filter that short-circuited the matched route, or null.
+     *
+     * @return mixed
+     */
+    public function getFilterResponse(): mixed {
+        return $this->_filterResponse;
+    }
+
     /**
      * Return all filters.
      *
@@ -327,6 +546,43 @@ class Router implements Subject {
         return $this->_groups;
     }
 
+    /**
+     * Return the filter pipeline for a route. The pipeline is resolved once per filter chain and cached.
+     *
+     * @param \Titon\Route\Route $route
+     * @return \Titon\Route\Pipeline
+     * @throws \Titon\Route\Exception\MissingFilterException
+     */
+    public function getPipeline(Route $route): Pipeline {
+        $filters = $route->getFilters();
+        $key = implode(',', $filters);
+
+        if ($this->_pipelines->contains($key)) {
+            return $this->_pipelines[$key];
+        }
+
+        $pipeline = new Pipeline();
+
+        foreach ($filters as $filter) {
+            if ($this->_asyncFilters->contains($filter)) {
+                $pipeline->addAsync($this->_asyncFilters[$filter]);
+            } else {
+                $pipeline->add($this->getFilter($filter));
+            }
+        }
+
+        return $this->_pipelines[$key] = $pipeline;
+    }
+
+    /**
+     * Return the match cache.
+     *
+     * @return \Titon\Route\MatchCache
+     */
+    public function getMatchCache(): ?MatchCache {
+        return $this->_matchCache;
+    }
+
     /**
      * Return the matcher object.
      *
@@ -336,6 +592,25 @@ class Router implements Subject {
         return $this->_matcher;
     }
 
+    /**
+     * Return the tokenized routes that can respond to an HTTP method, in the order they were mapped.
+     * Static routes are excluded as they are matched through a path lookup.
+     *
+     * @param string $method
+     * @return \Titon\Route\RouteMap
+     */
+    public function getMethodRoutes(string $method): RouteMap {
+        $this->_buildIndex();
+
+        $method = strtolower($method);
+
+        if ($this->_methodRoutes->contains($method)) {
+            return $this->_methodRoutes[$method];
+        }
+
+        return $this->_methodRoutes->get('*') ?: Map {};
+    }
+
     /**
      * Return the CRUD action resource map.
      *
@@ -353,6 +628,10 @@ class Router implements Subject {
      * @throws \Titon\Route\Exception\MissingRouteException
      */
     public function getRoute(string $key): Route {
+        if (!$this->_routes->contains($key) && $this->_partitions->contains($key)) {
+            $this->_loadPartitions(Set {$this->_partitions[$key]});
+        }
+
         if ($this->_routes->contains($key)) {
             return $this->_routes[$key];
         }
@@ -361,11 +640,15 @@ class Router implements Subject {
     }
 
     /**
-     * Return all routes.
+     * Return all routes. If routes were loaded from the cache, all remaining partitions will be loaded.
      *
      * @return \Titon\Route\RouteMap
      */
     public function getRoutes(): RouteMap {
+        if ($this->_partitions) {
+            $this->_loadPartitions(new Set($this->_partitions->values()));
+        }
+
         return $this->_routes;
     }
 
@@ -453,8 +736,35 @@ class Router implements Subject {
         return $this->_cached;
     }
 
+    /**
+     * Load routes from a static dispatch table generated by the `RouteCompiler`.
+     * Since the table is a plain Hack file, it will be held in the opcode cache,
+     * and the routes will not need to be unserialized or re-compiled.
+     *
+     * @param string $path
+     * @return $this
+     * @throws \Titon\Common\Exception\MissingFileException
+     */
+    public function loadCompiled(string $path): this {
+        $routes = Map {};
+
+        foreach (include_file($path) as $key => $data) {
+            $routes[$key] = Route::import($data);
+        }
+
+        $this->_routes = $routes;
+        $this->_partitions = Map {};
+        $this->_fingerprint = null;
+        $this->_cached = true;
+        $this->_indexed = false;
+
+        return $this;
+    }
+
     /**
      * Add a custom defined route object that matches to an internal destination.
+     * Routes are indexed by their path and HTTP methods on the next match, so the returned route can still be
+     * modified fluently. A route that is modified after matching has started should be mapped again.
      *
      * @param string $key
      * @param \Titon\Route\Route $route
@@ -462,6 +772,8 @@ class Router implements Subject {
      */
     public function map(string $key, Route $route): Route {
         $this->_routes[$key] = $route;
+        $this->_fingerprint = null;
+        $this->_indexed = false;
 
         // Apply group options
         foreach ($this->getGroups() as $group) {
@@ -496,7 +808,12 @@ class Router implements Subject {
     }
 
     /**
-     * Attempt to match an internal route.
+     * Attempt to match an internal route. If a match cache is set, previously matched URLs are returned from it.
+     * Otherwise static routes are looked up by path, and the matcher loops over the tokenized routes
+     * for the current HTTP method. The first route that was mapped wins, so the matcher is skipped
+     * when a static route matched before any tokenized route was mapped. Once matched, the `matched` event is emitted
+     * and the route's filter pipeline is run, and the response of a filter that short-circuited is returned
+     * by `Route::dispatch()` and `getFilterResponse()`.
      *
      * @param string $url
      * @return \Titon\Route\Route
@@ -505,7 +822,30 @@ class Router implements Subject {
     public function match(string $url): Route {
         $this->emit('route.matching', [$this, $url]);
 
-        $match = $this->getMatcher()->match($url, $this->getRoutes());
+        $method = (string) Server::get('REQUEST_METHOD');
+        $cache = $this->getMatchCache();
+        $cacheKey = implode(':', [strtolower($method), Route::isSecureRequest() ? 'https' : 'http', $url]);
+        $match = null;
+
+        if ($cache) {
+            $match = $this->_matchCached($cache, $cacheKey);
+        }
+
+        if (!$match) {
+            $match = $this->_matchStatic($url);
+
+            if (!$match || $this->_isShadowable($match)) {
+                $tokenized = $this->getMatcher()->match($url, $this->getMethodRoutes($method));
+
+                if ($tokenized && (!$match || $this->_getPosition($tokenized) < $this->_getPosition($match))) {
+                    $match = $tokenized;
+                }
+            }
+
+            if ($match && $cache) {
+                $this->_cacheMatch($cache, $cacheKey, $match);
+            }
+        }
 
         if (!$match) {
             throw new NoMatchException(sprintf('No route has been matched for %s', $url));
@@ -515,6 +855,8 @@ class Router implements Subject {
 
         $this->emit('route.matched', [$this, $match]);
 
+        $this->_runFilters($match);
+
         return $match;
     }
 
@@ -664,6 +1006,18 @@ class Router implements Subject {
         return $this;
     }
 
+    /**
+     * Set the match cache, which will memoize matched URLs.
+     *
+     * @param \Titon\Route\MatchCache $cache
+     * @return $this
+     */
+    public function setMatchCache(MatchCache $cache): this {
+        $this->_matchCache = $cache;
+
+        return $this;
+    }
+
     /**
      * Update the resource mapping.
      *
@@ -688,4 +1042,321 @@ class Router implements Subject {
         return $this;
     }
 
+    /**
+     * Build the static path and HTTP method indices if routes have changed since they were last built.
+     */
+    protected function _buildIndex(): void {
+        if (!$this->_indexed) {
+            $this->_indexRoutes();
+        }
+    }
+
+    /**
+     * Memoize a matched route, along with the values that were matched, in the match cache.
+     * Routes with conditions are not memoized as the conditions may depend on anything. Neither are routes
+     * mapped after a route with conditions, as they may have only matched because those conditions failed.
+     *
+     * @param \Titon\Route\MatchCache $cache
+     * @param string $cacheKey
+     * @param \Titon\Route\Route $route
+     */
+    protected function _cacheMatch(MatchCache $cache, string $cacheKey, Route $route): void {
+        $key = $this->_getRouteKey($route);
+
+        if ($key === null || ($this->_firstConditional >= 0 && $this->_firstConditional <= $this->_positions[$key])) {
+            return;
+        }
+
+        $cache->set($this->getFingerprint(), $cacheKey, shape(
+            'route' => $key,
+            'url' => $route->url(),
+            'params' => $route->getParams()->toArray()
+        ));
+    }
+
+    /**
+     * Return the storage key for a cache partition.
+     *
+     * @param string $partition
+     * @return string
+     */
+    protected function _getPartitionKey(string $partition): string {
+        return 'routes.' . md5($partition);
+    }
+
+    /**
+     * Return the position a route was mapped in, or -1 if it has not been mapped.
+     *
+     * @param \Titon\Route\Route $route
+     * @return int
+     */
+    protected function _getPosition(Route $route): int {
+        $key = $this->_getRouteKey($route);
+
+        return ($key === null) ? -1 : $this->_positions[$key];
+    }
+
+    /**
+     * Return the cache partition a route belongs to, which is the first segment of its path.
+     * Routes that start with a token can match any URL, so are placed in the `*` partition.
+     *
+     * @param \Titon\Route\Route $route
+     * @return string
+     */
+    protected function _getRoutePartition(Route $route): string {
+        $segments = explode('/', trim($route->getPath(), '/'));
+
+        if (!$this->_isStaticPath($segments[0])) {
+            return '*';
+        }
+
+        // An optional token that is followed by other characters in the same segment
+        // will absorb the leading slash, so the first segment may not be complete
+        if (count($segments) > 1 && strpos($segments[1], '?') !== false && !preg_match('/^[\{\[\(\<][^\/]+\?[\}\]\)\>]$/', $segments[1])) {
+            return '*';
+        }
+
+        return strtolower($segments[0]);
+    }
+
+    /**
+     * Return the key a route was mapped with, or null if it has not been mapped.
+     *
+     * @param \Titon\Route\Route $route
+     * @return string
+     */
+    protected function _getRouteKey(Route $route): ?string {
+        $this->_buildIndex();
+
+        return $this->_keys->get(spl_object_hash($route));
+    }
+
+    /**
+     * Return the cache partition that a URL can be matched against.
+     *
+     * @param string $url
+     * @return string
+     */
+    protected function _getUrlPartition(string $url): string {
+        return strtolower(explode('/', trim($url, '/'))[0]);
+    }
+
+    /**
+     * Add a route to the static path index, or to the HTTP method index if it contains tokens.
+     *
+     * @param string $key
+     * @param \Titon\Route\Route $route
+     */
+    protected function _indexRoute(string $key, Route $route): void {
+        $path = $route->getPath();
+
+        $this->_keys[spl_object_hash($route)] = $key;
+        $this->_positions[$key] = count($this->_positions);
+
+        if ($this->_firstConditional < 0 && $route->getConditions()) {
+            $this->_firstConditional = $this->_positions[$key];
+        }
+
+        if ($this->_isStaticPath($path)) {
+            $path = $this->_normalizePath($path);
+
+            if (!$this->_staticRoutes->contains($path)) {
+                $this->_staticRoutes[$path] = Map {};
+            }
+
+            $this->_staticRoutes[$path][$key] = $route;
+
+            return;
+        }
+
+        if ($this->_firstTokenized < 0) {
+            $this->_firstTokenized = $this->_positions[$key];
+        }
+
+        $methods = $route->getMethods();
+
+        // Seed new method groups with the routes that respond to all methods
+        foreach ($methods as $method) {
+            if (!$this->_methodRoutes->contains($method)) {
+                $this->_methodRoutes[$method] = ($this->_methodRoutes->get('*') ?: Map {})->toMap();
+            }
+
+            $this->_methodRoutes[$method][$key] = $route;
+        }
+
+        if (!$methods) {
+            if (!$this->_methodRoutes->contains('*')) {
+                $this->_methodRoutes['*'] = Map {};
+            }
+
+            foreach ($this->_methodRoutes as $group) {
+                $group[$key] = $route;
+            }
+        }
+    }
+
+    /**
+     * Rebuild the static path and HTTP method indices from all mapped routes.
+     */
+    protected function _indexRoutes(): void {
+        $this->_keys = Map {};
+        $this->_methodRoutes = Map {};
+        $this->_positions = Map {};
+        $this->_staticRoutes = Map {};
+        $this->_firstConditional = -1;
+        $this->_firstTokenized = -1;
+
+        foreach ($this->_routes as $key => $route) {
+            $this->_indexRoute($key, $route);
+        }
+
+        $this->_indexed = true;
+    }
+
+    /**
+     * Return true if a tokenized route was mapped before the static route, in which case it may take precedence.
+     *
+     * @param \Titon\Route\Route $route
+     * @return bool
+     */
+    protected function _isShadowable(Route $route): bool {
+        return ($this->_firstTokenized >= 0 && $this->_firstTokenized < $this->_getPosition($route));
+    }
+
+    /**
+     * Return true if the path contains no tokens or regex characters,
+     * in which case it can only be matched by the path itself.
+     *
+     * @param string $path
+     * @return bool
+     */
+    protected function _isStaticPath(string $path): bool {
+        return !preg_match('/[\{\}\[\]\(\)\<\>\\\\\+\*\?\^\$\|]/', $path);
+    }
+
+    /**
+     * Load cache partitions that have not been loaded yet, and merge their routes
+     * into the route list while keeping the order they were mapped in.
+     * Return false if a partition is missing from the cache.
+     *
+     * @param Set<string> $partitions
+     * @return bool
+     */
+    protected function _loadPartitions(Set<string> $partitions): bool {
+        $storage = $this->getStorage();
+        $available = new Set($this->_partitions->values());
+        $loaded = Map {};
+
+        foreach ($partitions as $partition) {
+            if ($this->_partitionsLoaded->contains($partition) || !$available->contains($partition)) {
+                continue;
+            }
+
+            $item = $storage?->getItem($this->_getPartitionKey($partition));
+
+            if ($item === null || !$item->isHit()) {
+                return false;
+            }
+
+            $loaded->setAll(unserialize($item->get()));
+            $this->_partitionsLoaded[] = $partition;
+        }
+
+        if (!$loaded) {
+            return true;
+        }
+
+        $routes = Map {};
+
+        foreach ($this->_partitions as $key => $partition) {
+            if ($loaded->contains($key)) {
+                $routes[$key] = $loaded[$key];
+
+            } else if ($this->_routes->contains($key)) {
+                $routes[$key] = $this->_routes[$key];
+            }
+        }
+
+        // Routes mapped after the cache was loaded
+        foreach ($this->_routes as $key => $route) {
+            if (!$routes->contains($key)) {
+                $routes[$key] = $route;
+            }
+        }
+
+        $this->_routes = $routes;
+        $this->_indexed = false;
+
+        return true;
+    }
+
+    /**
+     * Attempt to match a route from the match cache. The route is populated with the previously matched values,
+     * but its HTTP method, scheme and conditions are not checked, as those are part of the cache key.
+     *
+     * @param \Titon\Route\MatchCache $cache
+     * @param string $cacheKey
+     * @return \Titon\Route\Route
+     */
+    protected function _matchCached(MatchCache $cache, string $cacheKey): ?Route {
+        $result = $cache->get($this->getFingerprint(), $cacheKey);
+
+        if ($result === null) {
+            return null;
+        }
+
+        try {
+            return $this->getRoute($result['route'])->restore($result['url'], new Map($result['params']));
+        } catch (MissingRouteException $e) {
+            return null;
+        }
+    }
+
+    /**
+     * Attempt to match a static route by looking up the URL in the path index.
+     *
+     * @param string $url
+     * @return \Titon\Route\Route
+     */
+    protected function _matchStatic(string $url): ?Route {
+        $this->_buildIndex();
+
+        $routes = $this->_staticRoutes->get($this->_normalizePath($url));
+
+        if ($routes) {
+            foreach ($routes as $route) {
+                if ($route->isMatch($url)) {
+                    return $route;
+                }
+            }
+        }
+
+        return null;
+    }
+
+    /**
+     * Normalize a path or URL for use as a static index key.
+     *
+     * @param string $path
+     * @return string
+     */
+    protected function _normalizePath(string $path): string {
+        return '/' . strtolower(trim($path, '/'));
+    }
+
+    /**
+     * Run the filter pipeline of a route, and store the response of a filter that short-circuited it.
+     *
+     * @param \Titon\Route\Route $route
+     */
+    protected function _runFilters(Route $route): void {
+        $response = $route->getFilters() ? $this->getPipeline($route)->run($this, $route) : null;
+
+        $this->_filterResponse = $response;
+
+        if ($response !== null) {
+            $route->setFilterResponse($response);
+        }
+    }
+
 }
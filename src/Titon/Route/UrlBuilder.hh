@@ -13,15 +13,40 @@ use Titon\Route\Exception\MissingTokenException;
 use Titon\Utility\Config;
 use Titon\Utility\Inflector;
 
+type UrlTemplate = shape(
+    'route' => Route,
+    'literals' => Vector<string>,
+    'slots' => Vector<string>,
+    'tokens' => TokenList
+);
+type UrlTemplateMap = Map<string, UrlTemplate>;
+
 /**
  * The UrlBuilder helps ease the process of building dynamic URLs based on the routes mapped in the Router.
  * Requires a Router instance to be passed through the constructor.
  *
+ * Each route is compiled once into a template of literal parts and token slots,
+ * so that building a URL is a single concatenation of the parts and the inflected parameters.
+ *
  * @package Titon\Route
  */
 class UrlBuilder {
     use Cacheable, FactoryAware;
 
+    /**
+     * The maximum number of inflected parameter values to keep in memory.
+     *
+     * @var int
+     */
+    protected int $_capacity = 1000;
+
+    /**
+     * Inflected parameter values, in least to most recently used order.
+     *
+     * @var Map<string, string>
+     */
+    protected Map<string, string> $_inflected = Map {};
+
     /**
      * Router instance.
      *
@@ -30,12 +55,21 @@ class UrlBuilder {
     protected Router $_router;
 
     /**
-     * Store the Router instance.
+     * Compiled templates, keyed by route key.
+     *
+     * @var \Titon\Route\UrlTemplateMap
+     */
+    protected UrlTemplateMap $_templates = Map {};
+
+    /**
+     * Store the Router instance, and the capacity of the inflected parameter cache.
      *
      * @param \Titon\Route\Router $router
+     * @param int $capacity
      */
-    public function __construct(Router $router) {
+    public function __construct(Router $router, int $capacity = 1000) {
         $this->_router = $router;
+        $this->_capacity = max(0, $capacity);
     }
 
     /**
@@ -49,46 +83,110 @@ class UrlBuilder {
      * @throws \Titon\Route\Exception\MissingTokenException
      */
     public function build(string $key, ParamMap $params = Map {}, QueryMap $query = Map {}): string {
-        $url = (string) $this->cache([__METHOD__, $key, $params], function(UrlBuilder $builder) use ($key, $params) {
-            $router = $builder->getRouter();
-            $route = $router->getRoute($key);
-            $base = $router->base();
-            $url = str_replace([']', ')', '>'], '}', str_replace(['[', '(', '<'], '{', $route->getPath()));
+        return $this->_appendQuery($this->_buildPath($key, $this->getTemplate($key), $params), $query);
+    }
 
-            // Set the locale if it is missing
-            if (!$params->contains('locale')) {
-                $params['locale'] = Config::get('titon.locale.current');
-            }
+    /**
+     * Build multiple URLs for the same route, one for each list of parameters.
+     * The route template is only resolved once, which is ideal for rendering large lists of links.
+     *
+     * @param string $key
+     * @param Vector<\Titon\Route\ParamMap> $paramsList
+     * @param \Titon\Route\QueryMap $query
+     * @return Vector<string>
+     * @throws \Titon\Route\Exception\MissingTokenException
+     */
+    public function buildMany(string $key, Vector<ParamMap> $paramsList, QueryMap $query = Map {}): Vector<string> {
+        $template = $this->getTemplate($key);
+        $urls = Vector {};
 
-            // Replace tokens in the path with values from the parameters
-            foreach ($route->getTokens() as $token) {
-                $tokenKey = $token['token'];
+        foreach ($paramsList as $params) {
+            $urls[] = $this->_appendQuery($this->_buildPath($key, $template, $params), $query);
+        }
 
-                if ($params->contains($tokenKey) || $token['optional']) {
-                    $url = str_replace(sprintf('{%s}', $tokenKey . ($token['optional'] ? '?' : '')), Inflector::route((string) $params->get($tokenKey) ?: ''), $url);
+        return $urls;
+    }
 
-                } else {
-                    throw new MissingTokenException(sprintf('Missing %s parameter for the %s route', $tokenKey, $key));
-                }
-            }
+    /**
+     * Return the capacity of the inflected parameter cache.
+     *
+     * @return int
+     */
+    public function getCapacity(): int {
+        return $this->_capacity;
+    }
+
+    /**
+     * Return the Router instance.
+     *
+     * @return \Titon\Route\Router
+     */
+    public function getRouter(): Router {
+        return $this->_router;
+    }
+
+    /**
+     * Return the compiled template for a route, and compile it if the route has not been seen,
+     * or has been re-mapped since.
+     *
+     * @param string $key
+     * @return \Titon\Route\UrlTemplate
+     * @throws \Titon\Route\Exception\MissingRouteException
+     */
+    public function getTemplate(string $key): UrlTemplate {
+        $route = $this->getRouter()->getRoute($key);
+
+        if ($this->_templates->contains($key) && $this->_templates[$key]['route'] === $route) {
+            return $this->_templates[$key];
+        }
+
+        return $this->_templates[$key] = $this->_compileTemplate($route);
+    }
+
+    /**
+     * Return the current URL.
+     *
+     * @return string
+     */
+    public function url(): string {
+        return (string) $this->cache(__METHOD__, (UrlBuilder $builder) ==> {
+            $router = $builder->getRouter();
+            $segments = $router->getSegments();
+            $base = $router->base();
+            $url = (string) $segments['scheme'] . '://' . (string) $segments['host'];
 
-            // Prepend base folder
             if ($base !== '/') {
-                $url = $base . $url;
+                $url .= $base;
             }
 
-            // Trim trailing slash
-            if ($url !== '/') {
-                $url = rtrim($url, '/');
+            $url .= (string) $segments['path'];
+
+            if ($segments['query']) {
+                $url .= '?' . http_build_query($segments['query']);
             }
 
             return $url;
         });
+    }
+
+    /**
+     * Append a query string and fragment to a URL.
+     *
+     * @param string $url
+     * @param \Titon\Route\QueryMap $query
+     * @return string
+     */
+    protected function _appendQuery(string $url, QueryMap $query): string {
+        if (!$query) {
+            return $url;
+        }
 
-        // Append query string and fragment
         $fragment = $query->get('#');
 
-        $query->remove('#');
+        if ($fragment !== null) {
+            $query = $query->toMap();
+            $query->remove('#');
+        }
 
         if ($query) {
             $url .= '?' . http_build_query($query);
@@ -102,38 +200,128 @@ class UrlBuilder {
     }
 
     /**
-     * Return the Router instance.
+     * Build the path of a URL by concatenating the literal parts of a template with the inflected parameters.
      *
-     * @return \Titon\Route\Router
+     * @param string $key
+     * @param \Titon\Route\UrlTemplate $template
+     * @param \Titon\Route\ParamMap $params
+     * @return string
+     * @throws \Titon\Route\Exception\MissingTokenException
      */
-    public function getRouter(): Router {
-        return $this->_router;
+    protected function _buildPath(string $key, UrlTemplate $template, ParamMap $params): string {
+        foreach ($template['tokens'] as $token) {
+            $tokenKey = $token['token'];
+
+            // The locale falls back to the current locale
+            if (!$token['optional'] && $tokenKey !== 'locale' && !$params->contains($tokenKey)) {
+                throw new MissingTokenException(sprintf('Missing %s parameter for the %s route', $tokenKey, $key));
+            }
+        }
+
+        $literals = $template['literals'];
+        $url = $literals[0];
+
+        foreach ($template['slots'] as $i => $slot) {
+            $value = $params->get($slot);
+
+            if ($value === null && $slot === 'locale') {
+                $value = Config::get('titon.locale.current');
+            }
+
+            $url .= $this->_inflect((string) $value) . $literals[$i + 1];
+        }
+
+        // Trim trailing slash
+        if ($url !== '/') {
+            $url = rtrim($url, '/');
+        }
+
+        return $url;
     }
 
     /**
-     * Return the current URL.
+     * Compile a route into a template of literal parts, separated by the tokens that will be replaced.
+     * The base folder is prepended to the first literal part.
      *
-     * @return string
+     * @param \Titon\Route\Route $route
+     * @return \Titon\Route\UrlTemplate
      */
-    public function url(): string {
-        return (string) $this->cache(__METHOD__, (UrlBuilder $builder) ==> {
-            $router = $builder->getRouter();
-            $segments = $router->getSegments();
-            $base = $router->base();
-            $url = (string) $segments['scheme'] . '://' . (string) $segments['host'];
+    protected function _compileTemplate(Route $route): UrlTemplate {
+        $route->compile();
 
-            if ($base !== '/') {
-                $url .= $base;
+        $path = str_replace([']', ')', '>'], '}', str_replace(['[', '(', '<'], '{', $route->getPath()));
+        $positions = [];
+
+        foreach ($route->getTokens() as $token) {
+            $pos = strpos($path, sprintf('{%s}', $token['token'] . ($token['optional'] ? '?' : '')));
+
+            if ($pos !== false) {
+                $positions[$pos] = $token;
             }
+        }
 
-            $url .= (string) $segments['path'];
+        ksort($positions);
 
-            if ($segments['query']) {
-                $url .= '?' . http_build_query($segments['query']);
+        $literals = Vector {};
+        $slots = Vector {};
+        $offset = 0;
+
+        foreach ($positions as $pos => $token) {
+            $literals[] = substr($path, $offset, $pos - $offset);
+            $slots[] = $token['token'];
+            $offset = $pos + strlen($token['token']) + ($token['optional'] ? 3 : 2);
+        }
+
+        $literals[] = (string) substr($path, $offset);
+
+        // Prepend base folder
+        $base = $this->getRouter()->base();
+
+        if ($base !== '/') {
+            $literals[0] = $base . $literals[0];
+        }
+
+        return shape(
+            'route' => $route,
+            'literals' => $literals,
+            'slots' => $slots,
+            'tokens' => $route->getTokens()
+        );
+    }
+
+    /**
+     * Inflect a parameter value for use in a URL. This is the same inflection as `Inflector::route()`,
+     * but the results are stored in a bounded least recently used cache instead of a static cache,
+     * so that rendering thousands of unique links does not grow memory without limit.
+     *
+     * @param string $value
+     * @return string
+     */
+    protected function _inflect(string $value): string {
+        if ($value === '') {
+            return '';
+        }
+
+        $inflected = $this->_inflected->get($value);
+
+        // Move to the end of the list as it was most recently used
+        if ($inflected !== null) {
+            $this->_inflected->remove($value);
+
+            return $this->_inflected[$value] = $inflected;
+        }
+
+        $inflected = Inflector::routeUncached($value);
+
+        if ($this->_capacity) {
+            if (count($this->_inflected) >= $this->_capacity) {
+                $this->_inflected->remove($this->_inflected->firstKey());
             }
 
-            return $url;
-        });
+            $this->_inflected[$value] = $inflected;
+        }
+
+        return $inflected;
     }
 
 }
\ No newline at end of file
@@ -0,0 +1,167 @@
+<?hh // strict
+/**
+ * @copyright   2010-2015, The Titon Project
+ * @license     http://opensource.org/licenses/bsd-license.php
+ * @link        http://titon.io
+ */
+
+namespace Titon\Test;
+
+type BenchmarkCallback = (function(int): mixed);
+type BenchmarkResult = shape('name' => string, 'iterations' => int, 'nsPerOp' => float, 'memory' => int);
+type BenchmarkResultMap = Map<string, BenchmarkResult>;
+
+/**
+ * A BenchmarkSuite measures the average time per operation, and the memory retained, for a set of callbacks.
+ * Results can be written as JSON and compared against a previously stored baseline to detect regressions.
+ *
+ * @package Titon\Test
+ */
+abstract class BenchmarkSuite {
+
+    /**
+     * Results of all measured benchmarks, in the order they were run.
+     *
+     * @var \Titon\Test\BenchmarkResultMap
+     */
+    protected BenchmarkResultMap $_results = Map {};
+
+    /**
+     * Run all benchmarks in the suite.
+     */
+    abstract public function run(): void;
+
+    /**
+     * Compare the results against a baseline and return the benchmarks that regressed,
+     * along with the ratio of the current time to the baseline time.
+     *
+     * @param \Titon\Test\BenchmarkResultMap $baseline
+     * @param float $tolerance
+     * @return Map<string, float>
+     */
+    public function compare(BenchmarkResultMap $baseline, float $tolerance = 0.1): Map<string, float> {
+        $regressions = Map {};
+
+        foreach ($this->getResults() as $name => $result) {
+            if (!$baseline->contains($name) || $baseline[$name]['nsPerOp'] <= 0) {
+                continue;
+            }
+
+            $ratio = $result['nsPerOp'] / $baseline[$name]['nsPerOp'];
+
+            if ($ratio > (1 + $tolerance)) {
+                $regressions[$name] = $ratio;
+            }
+        }
+
+        return $regressions;
+    }
+
+    /**
+     * Return all results.
+     *
+     * @return \Titon\Test\BenchmarkResultMap
+     */
+    public function getResults(): BenchmarkResultMap {
+        return $this->_results;
+    }
+
+    /**
+     * Load a baseline from a JSON file that was previously written with `write()`.
+     *
+     * @param string $path
+     * @return \Titon\Test\BenchmarkResultMap
+     */
+    public static function loadBaseline(string $path): BenchmarkResultMap {
+        $baseline = Map {};
+
+        if (!file_exists($path)) {
+            return $baseline;
+        }
+
+        $results = json_decode(file_get_contents($path), true);
+
+        if (is_array($results)) {
+            foreach ($results as $name => $result) {
+                $baseline[$name] = shape(
+                    'name' => (string) $name,
+                    'iterations' => (int) $result['iterations'],
+                    'nsPerOp' => (float) $result['nsPerOp'],
+                    'memory' => (int) $result['memory']
+                );
+            }
+        }
+
+        return $baseline;
+    }
+
+    /**
+     * Measure the average time of a callback over a number of iterations, and the memory retained afterwards.
+     * The current iteration is passed to the callback.
+     *
+     * @param string $name
+     * @param int $iterations
+     * @param \Titon\Test\BenchmarkCallback $callback
+     * @return \Titon\Test\BenchmarkResult
+     */
+    public function measure(string $name, int $iterations, BenchmarkCallback $callback): BenchmarkResult {
+        $iterations = max(1, $iterations);
+
+        gc_collect_cycles();
+
+        $memory = memory_get_usage();
+        $start = microtime(true);
+
+        for ($i = 0; $i < $iterations; $i++) {
+            $callback($i);
+        }
+
+        $time = microtime(true) - $start;
+
+        return $this->_results[$name] = shape(
+            'name' => $name,
+            'iterations' => $iterations,
+            'nsPerOp' => ($time * 1000000000) / $iterations,
+            'memory' => memory_get_usage() - $memory
+        );
+    }
+
+    /**
+     * Format the results as a human readable table.
+     *
+     * @return string
+     */
+    public function output(): string {
+        $output = '';
+
+        foreach ($this->getResults() as $result) {
+            $output .= sprintf("%-50s %10s ns/op %12s bytes (%s ops)\n",
+                $result['name'],
+                number_format($result['nsPerOp'], 0),
+                number_format($result['memory']),
+                $result['iterations']);
+        }
+
+        return $output;
+    }
+
+    /**
+     * Return the results as a JSON string.
+     *
+     * @return string
+     */
+    public function toJson(): string {
+        return json_encode($this->getResults()->toArray(), JSON_PRETTY_PRINT);
+    }
+
+    /**
+     * Write the results as JSON to a file, which can be used as a baseline for future runs.
+     *
+     * @param string $path
+     * @return bool
+     */
+    public function write(string $path): bool {
+        return (bool) file_put_contents($path, $this->toJson());
+    }
+
+}
@@ -71,7 +71,7 @@ class Inflector {
      */
     public static function hyphenate(string $string): string {
         return (string) static::cache([__METHOD__, $string], () ==> {
-            return str_replace(' ', '-', preg_replace('/\s{2,}+/', ' ', $string));
+            return Inflector::_hyphenate($string);
         });
     }
 
@@ -115,10 +115,21 @@ class Inflector {
      */
     public static function route(string $string): string {
         return (string) static::cache([__METHOD__, $string], () ==> {
-            return mb_strtolower(Inflector::hyphenate(str_replace('_', '-', preg_replace('/[^-_a-z0-9\s\.]+/i', '', $string))));
+            return Inflector::routeUncached($string);
         });
     }
 
+    /**
+     * Inflect a word for a URL like `route()`, but without storing the result in the static cache.
+     * Should be used by callers that inflect many unique values and manage their own cache.
+     *
+     * @param string $string
+     * @return string
+     */
+    public static function routeUncached(string $string): string {
+        return mb_strtolower(static::_hyphenate(str_replace('_', '-', preg_replace('/[^-_a-z0-9\s\.]+/i', '', $string))));
+    }
+
     /**
      * Inflect a string to its singular form.
      *
@@ -222,4 +233,14 @@ class Inflector {
         return $string;
     }
 
+    /**
+     * Replace spaces with dashes, collapsing multiple spaces into a single dash.
+     *
+     * @param string $string
+     * @return string
+     */
+    protected static function _hyphenate(string $string): string {
+        return str_replace(' ', '-', preg_replace('/\s{2,}+/', ' ', $string));
+    }
+
 }
\ No newline at end of file
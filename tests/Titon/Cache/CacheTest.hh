@@ -92,6 +92,17 @@ class CacheTest extends TestCase {
         $this->assertEquals(2, $this->object->get('increment', 'custom')->get());
     }
 
+    public function testInvalidateTags() {
+        $this->object->store('tagged', () ==> 'foo', '+1 hour', 'default', ['posts']);
+        $this->object->store('tagged', () ==> 'bar', '+1 hour', 'custom', ['posts']);
+
+        $this->object->invalidateTags(['posts']);
+
+        $this->assertFalse($this->object->has('tagged'));
+        $this->assertTrue($this->object->has('tagged', 'custom'));
+        $this->assertTrue($this->object->has('key'));
+    }
+
     public function testRemove() {
         $this->assertEquals('foo', $this->object->get('key')->get());
 
@@ -125,7 +136,7 @@ class CacheTest extends TestCase {
     }
 
     public function testStorages() {
-        $this->object->addStorage('test', new MemoryStorage(Map {'storage' => 'test'}));
+        $this->object->addStorage('test', new MemoryStorage());
 
         $this->assertInstanceOf('Titon\Cache\Storage', $this->object->getStorage('test'));
         $this->assertEquals(['default', 'custom', 'test'], array_keys($this->object->getStorages()));
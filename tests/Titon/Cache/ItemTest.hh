@@ -40,6 +40,13 @@ class ItemTest extends TestCase {
         $this->assertEquals('baz', $this->object->getKey());
     }
 
+    public function testGetSetTags() {
+        $this->assertEquals([], $this->object->getTags());
+
+        $this->object->setTags(['user.5', 'posts', 'user.5']);
+        $this->assertEquals(['user.5', 'posts'], $this->object->getTags());
+    }
+
     public function testIsHit() {
         $this->assertFalse($this->object->isHit());
 
@@ -0,0 +1,32 @@
+<?hh
+namespace Titon\Cache\Serializer;
+
+use Titon\Cache\Serializer;
+use Titon\Test\TestCase;
+
+/**
+ * @property \Titon\Cache\Serializer\IgbinarySerializer $object
+ */
+class IgbinarySerializerTest extends TestCase {
+
+    protected function setUp() {
+        parent::setUp();
+
+        if (!IgbinarySerializer::isAvailable()) {
+            $this->markTestSkipped('igbinary is not installed');
+        }
+
+        $this->object = new IgbinarySerializer();
+    }
+
+    public function testGetFlag() {
+        $this->assertEquals(Serializer::IGBINARY, $this->object->getFlag());
+    }
+
+    public function testSerialize() {
+        $value = ['foo' => 'bar', 'date' => new \DateTime('2015-01-01 00:00:00')];
+
+        $this->assertEquals($value, $this->object->unserialize($this->object->serialize($value)));
+    }
+
+}
@@ -0,0 +1,41 @@
+<?hh
+namespace Titon\Cache\Serializer;
+
+use Titon\Cache\Serializer;
+use Titon\Test\TestCase;
+
+/**
+ * @property \Titon\Cache\Serializer\JsonSerializer $object
+ */
+class JsonSerializerTest extends TestCase {
+
+    protected function setUp() {
+        parent::setUp();
+
+        $this->object = new JsonSerializer();
+    }
+
+    public function testGetFlag() {
+        $this->assertEquals(Serializer::JSON, $this->object->getFlag());
+    }
+
+    public function testIsSupported() {
+        $this->assertTrue($this->object->isSupported(['foo' => 'bar', 'ids' => [1, 2, 3], 'active' => true, 'parent' => null]));
+        $this->assertTrue($this->object->isSupported('foo'));
+        $this->assertFalse($this->object->isSupported(1.0));
+        $this->assertFalse($this->object->isSupported(new \DateTime()));
+        $this->assertFalse($this->object->isSupported(['foo' => ['date' => new \DateTime()]]));
+        $this->assertTrue($this->object->isSupported('Tïtön'));
+        $this->assertFalse($this->object->isSupported("\xB1\x31"));
+        $this->assertFalse($this->object->isSupported(['foo' => "\xB1\x31"]));
+        $this->assertFalse($this->object->isSupported(["\xB1\x31" => 'foo']));
+    }
+
+    public function testSerialize() {
+        $value = ['foo' => 'bar', 'ids' => [1, 2, 3]];
+
+        $this->assertEquals('{"foo":"bar","ids":[1,2,3]}', $this->object->serialize($value));
+        $this->assertSame($value, $this->object->unserialize($this->object->serialize($value)));
+    }
+
+}
@@ -0,0 +1,34 @@
+<?hh
+namespace Titon\Cache\Serializer;
+
+use Titon\Cache\Serializer;
+use Titon\Test\TestCase;
+
+/**
+ * @property \Titon\Cache\Serializer\PhpSerializer $object
+ */
+class PhpSerializerTest extends TestCase {
+
+    protected function setUp() {
+        parent::setUp();
+
+        $this->object = new PhpSerializer();
+    }
+
+    public function testGetFlag() {
+        $this->assertEquals(Serializer::PHP, $this->object->getFlag());
+    }
+
+    public function testIsSupported() {
+        $this->assertTrue($this->object->isSupported(['foo' => 'bar']));
+        $this->assertTrue($this->object->isSupported(new \DateTime()));
+    }
+
+    public function testSerialize() {
+        $date = new \DateTime('2015-01-01 00:00:00');
+
+        $this->assertEquals(serialize($date), $this->object->serialize($date));
+        $this->assertEquals($date, $this->object->unserialize($this->object->serialize($date)));
+    }
+
+}
@@ -0,0 +1,33 @@
+<?hh
+namespace Titon\Cache\Serializer;
+
+use Titon\Cache\Serializer;
+use Titon\Test\TestCase;
+
+/**
+ * @property \Titon\Cache\Serializer\RawSerializer $object
+ */
+class RawSerializerTest extends TestCase {
+
+    protected function setUp() {
+        parent::setUp();
+
+        $this->object = new RawSerializer();
+    }
+
+    public function testGetFlag() {
+        $this->assertEquals(Serializer::RAW, $this->object->getFlag());
+    }
+
+    public function testIsSupported() {
+        $this->assertTrue($this->object->isSupported('<div>Titon</div>'));
+        $this->assertFalse($this->object->isSupported(123));
+        $this->assertFalse($this->object->isSupported(['foo']));
+    }
+
+    public function testSerialize() {
+        $this->assertSame('<div>Titon</div>', $this->object->serialize('<div>Titon</div>'));
+        $this->assertSame('<div>Titon</div>', $this->object->unserialize('<div>Titon</div>'));
+    }
+
+}
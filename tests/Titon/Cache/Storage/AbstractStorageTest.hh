@@ -3,6 +3,10 @@ namespace Titon\Cache\Storage;
 
 use Titon\Cache\HitItem;
 use Titon\Cache\Item;
+use Titon\Cache\MissItem;
+use Titon\Cache\Serializer\JsonSerializer;
+use Titon\Cache\Serializer\PhpSerializer;
+use Titon\Cache\Serializer\RawSerializer;
 use Titon\Test\TestCase;
 
 /**
@@ -26,6 +30,14 @@ abstract class AbstractStorageTest extends TestCase {
         }
     }
 
+    public function testAdd() {
+        $this->assertFalse($this->object->add('foo', 'bar', strtotime('+5 minutes')));
+        $this->assertEquals(['username' => 'Titon'], $this->object->get('foo'));
+
+        $this->assertTrue($this->object->add('baz', 'qux', strtotime('+5 minutes')));
+        $this->assertEquals('qux', $this->object->get('baz'));
+    }
+
     public function testClear() {
         $this->assertTrue($this->object->has('foo'));
 
@@ -117,6 +129,28 @@ abstract class AbstractStorageTest extends TestCase {
         $this->assertFalse($item->isHit());
     }
 
+    public function testGetItems() {
+        $this->assertEquals(Map {
+            'foo' => new HitItem('foo', ['username' => 'Titon']),
+            'bar' => new MissItem('bar'),
+            'count' => new HitItem('count', 1)
+        }, $this->object->getItems(['foo', 'bar', 'count']));
+
+        $this->assertEquals(Map {}, $this->object->getItems([]));
+    }
+
+    public function testCommitDeferredSkipsExpired() {
+        $this->object->saveDeferred(new Item('baz', 123, '+5 minutes'));
+        $this->object->saveDeferred(new Item('qux', 456, '+10 minutes'));
+        $this->object->saveDeferred(new Item('expired', 789, '-1 day'));
+
+        $this->assertTrue($this->object->commit());
+
+        $this->assertEquals(123, $this->object->get('baz'));
+        $this->assertEquals(456, $this->object->get('qux'));
+        $this->assertFalse($this->object->has('expired'));
+    }
+
     public function testHas() {
         $this->assertTrue($this->object->has('foo'));
         $this->assertFalse($this->object->has('foobar'));
@@ -133,6 +167,90 @@ abstract class AbstractStorageTest extends TestCase {
         $this->assertSame(6, $this->object->increment('missing', 5));
     }
 
+    public function testInvalidateTags() {
+        $this->object->save((new Item('post.1', 'Post', '+5 minutes'))->setTags(['posts']));
+        $this->object->save((new Item('user.1', 'User', '+5 minutes'))->setTags(['users']));
+
+        $this->assertTrue($this->object->has('post.1'));
+        $this->assertEquals('Post', $this->object->get('post.1'));
+
+        $this->object->invalidateTags(['posts']);
+
+        $this->assertFalse($this->object->has('post.1'));
+        $this->assertSame(null, $this->object->tryGet('post.1'));
+        $this->assertFalse($this->object->getItem('post.1')->isHit());
+        $this->assertEquals('User', $this->object->get('user.1'));
+        $this->assertEquals(['username' => 'Titon'], $this->object->get('foo'));
+
+        // Written again after the invalidation
+        $this->object->save((new Item('post.1', 'Post', '+5 minutes'))->setTags(['posts']));
+
+        $this->assertEquals('Post', $this->object->get('post.1'));
+    }
+
+    public function testInvalidateTagsNamespaces() {
+        $this->object->save((new Item('a', 'A', '+5 minutes'))->setTags(['user.5']));
+        $this->object->save((new Item('b', 'B', '+5 minutes'))->setTags(['user.5.views']));
+        $this->object->save((new Item('c', 'C', '+5 minutes'))->setTags(['user.6']));
+
+        $this->object->invalidateTags(['user.5.views']);
+
+        $this->assertTrue($this->object->has('a'));
+        $this->assertFalse($this->object->has('b'));
+        $this->assertTrue($this->object->has('c'));
+
+        $this->object->invalidateTags(['user']);
+
+        $this->assertFalse($this->object->has('a'));
+        $this->assertFalse($this->object->has('c'));
+    }
+
+    public function testInvalidateTagsGetItems() {
+        $this->object->save((new Item('a', 'A', '+5 minutes'))->setTags(['x']));
+        $this->object->save((new Item('b', 'B', '+5 minutes'))->setTags(['y']));
+
+        $this->object->invalidateTags(['x']);
+
+        $items = $this->object->getItems(['a', 'b', 'foo']);
+
+        $this->assertFalse($items['a']->isHit());
+        $this->assertEquals('B', $items['b']->get());
+        $this->assertEquals(['username' => 'Titon'], $items['foo']->get());
+    }
+
+    public function testInvalidateTagsCommitDeferred() {
+        $this->object->saveDeferred((new Item('a', 'A', '+5 minutes'))->setTags(['x']));
+        $this->object->commit();
+
+        $this->assertEquals('A', $this->object->get('a'));
+
+        $this->object->invalidateTags(['x']);
+
+        $this->assertFalse($this->object->has('a'));
+    }
+
+    public function testInvalidateTagsCommitDeferredSharedTags() {
+        $this->object->saveDeferred((new Item('a', 'A', '+5 minutes'))->setTags(['user.1']));
+        $this->object->saveDeferred((new Item('b', 'B', '+10 minutes'))->setTags(['user.2']));
+        $this->object->saveDeferred((new Item('c', 'C', '+5 minutes'))->setTags(['user']));
+        $this->object->commit();
+
+        $this->assertEquals('A', $this->object->get('a'));
+        $this->assertEquals('B', $this->object->get('b'));
+        $this->assertEquals('C', $this->object->get('c'));
+
+        $this->object->invalidateTags(['user.1']);
+
+        $this->assertFalse($this->object->has('a'));
+        $this->assertTrue($this->object->has('b'));
+        $this->assertTrue($this->object->has('c'));
+
+        $this->object->invalidateTags(['user']);
+
+        $this->assertFalse($this->object->has('b'));
+        $this->assertFalse($this->object->has('c'));
+    }
+
     public function testRemove() {
         $this->assertTrue($this->object->has('foo'));
 
@@ -157,6 +275,65 @@ abstract class AbstractStorageTest extends TestCase {
         $this->assertFalse($this->object->has('bar'));
     }
 
+    public function testSerializers() {
+        $value = ['username' => 'Titon', 'ids' => [1, 2, 3]];
+        $date = new \DateTime('2015-01-01 00:00:00');
+
+        foreach ([new PhpSerializer(), new JsonSerializer(), new RawSerializer()] as $serializer) {
+            $this->object->setSerializer($serializer);
+
+            $this->assertSame($serializer, $this->object->getSerializer());
+
+            $this->object->set('array', $value, strtotime('+5 minutes'));
+            $this->object->set('object', $date, strtotime('+5 minutes')); // Falls back when not supported
+            $this->object->set('string', '<div>Titon</div>', strtotime('+5 minutes'));
+
+            $this->assertEquals($value, $this->object->get('array'));
+            $this->assertEquals($date, $this->object->get('object'));
+            $this->assertEquals('<div>Titon</div>', $this->object->get('string'));
+        }
+    }
+
+    public function testSerializersInvalidUtf8() {
+        $this->object->setSerializer(new JsonSerializer());
+        $this->object->set('binary', ['data' => "\xB1\x31"], strtotime('+5 minutes')); // Falls back to PHP
+
+        $this->assertEquals(['data' => "\xB1\x31"], $this->object->get('binary'));
+    }
+
+    public function testSerializersMixed() {
+        $this->object->setSerializer(new JsonSerializer());
+        $this->object->set('json', ['foo' => 'bar'], strtotime('+5 minutes'));
+
+        $this->object->setSerializer(new PhpSerializer());
+        $this->object->set('php', ['foo' => 'baz'], strtotime('+5 minutes'));
+
+        $this->assertEquals(['foo' => 'bar'], $this->object->get('json'));
+        $this->assertEquals(['foo' => 'baz'], $this->object->get('php'));
+    }
+
+    public function testCompression() {
+        $this->assertEquals(0, $this->object->getCompressionThreshold());
+
+        $this->object->setCompression(100);
+
+        $template = str_repeat('<div class="item">Titon</div>', 100);
+        $routes = array_fill(0, 100, ['path' => '/users/{id}', 'method' => 'GET']);
+
+        $this->object->set('template', $template, strtotime('+5 minutes'));
+        $this->object->set('routes', $routes, strtotime('+5 minutes'));
+        $this->object->set('small', 'Titon', strtotime('+5 minutes'));
+
+        $this->assertEquals($template, $this->object->get('template'));
+        $this->assertEquals($routes, $this->object->get('routes'));
+        $this->assertEquals('Titon', $this->object->get('small'));
+
+        // Still readable once compression is disabled
+        $this->object->setCompression(0);
+
+        $this->assertEquals($template, $this->object->get('template'));
+    }
+
     public function testSet() {
         $this->assertEquals(['username' => 'Titon'], $this->object->get('foo'));
 
@@ -183,4 +360,193 @@ abstract class AbstractStorageTest extends TestCase {
         }));
     }
 
+    public function testStoreFalseyValues() {
+        $count = 0;
+        $callback = function() use (&$count) {
+            $count++;
+
+            return 0;
+        };
+
+        $this->assertSame(0, $this->object->store('storeFalsey', $callback));
+        $this->assertSame(0, $this->object->store('storeFalsey', $callback));
+        $this->assertEquals(1, $count);
+    }
+
+    public function testStoreStampedeProtection() {
+        $count = 0;
+        $callback = function() use (&$count) {
+            $count++;
+
+            return 'fresh';
+        };
+
+        $this->object->enableStampedeProtection(5, 60, 0.0);
+
+        $this->assertEquals('fresh', $this->object->store('stampede', $callback));
+        $this->assertEquals('fresh', $this->object->store('stampede', $callback));
+        $this->assertEquals(1, $count);
+        $this->assertTrue($this->object->has('stampede' . AbstractStorage::META_SUFFIX));
+        $this->assertFalse($this->object->has('stampede' . AbstractStorage::LOCK_SUFFIX));
+    }
+
+    public function testStoreStampedeRemoveDeletesMeta() {
+        $this->object->enableStampedeProtection(5, 60, 0.0);
+        $this->object->store('stampede', () ==> 'fresh');
+
+        $this->assertTrue($this->object->remove('stampede'));
+        $this->assertFalse($this->object->has('stampede'));
+        $this->assertFalse($this->object->has('stampede' . AbstractStorage::META_SUFFIX));
+    }
+
+    public function testStoreStampedeReleasesLockOnException() {
+        $this->object->enableStampedeProtection(5, 60, 0.0);
+
+        try {
+            $this->object->store('stampede', function() {
+                throw new \Exception('Failed');
+            });
+        } catch (\Exception $e) {
+            $this->assertEquals('Failed', $e->getMessage());
+        }
+
+        $this->assertFalse($this->object->has('stampede' . AbstractStorage::LOCK_SUFFIX));
+    }
+
+    public function testStoreStampedeServesStaleWhileLocked() {
+        $count = 0;
+        $callback = function() use (&$count) {
+            $count++;
+
+            return 'fresh';
+        };
+
+        $this->object->enableStampedeProtection(5, 60, 0.0);
+        $this->object->set('stampede', 'stale', time() + 60);
+        $this->object->set('stampede' . AbstractStorage::META_SUFFIX, ['expires' => time() - 1, 'delta' => 0.1], time() + 60);
+
+        // Another process is recomputing
+        $this->object->add('stampede' . AbstractStorage::LOCK_SUFFIX, 1, time() + 5);
+
+        $this->assertEquals('stale', $this->object->store('stampede', $callback));
+        $this->assertEquals(0, $count);
+
+        // The other process failed to finish, so this one recomputes
+        $this->object->remove('stampede' . AbstractStorage::LOCK_SUFFIX);
+
+        $this->assertEquals('fresh', $this->object->store('stampede', $callback));
+        $this->assertEquals(1, $count);
+        $this->assertFalse($this->object->has('stampede' . AbstractStorage::LOCK_SUFFIX));
+    }
+
+    public function testStoreStampedeEarlyExpiration() {
+        $this->object->set('stampede', 'current', time() + 60);
+        $this->object->set('stampede' . AbstractStorage::META_SUFFIX, ['expires' => time() + 10, 'delta' => 1.0], time() + 60);
+
+        $this->object->enableStampedeProtection(5, 60, 0.0);
+
+        $this->assertEquals('current', $this->object->store('stampede', () ==> 'early'));
+
+        // A high beta makes an early recompute all but certain
+        $this->object->enableStampedeProtection(5, 60, 1000000000.0);
+
+        $this->assertEquals('early', $this->object->store('stampede', () ==> 'early'));
+    }
+
+    public function testStoreStampedeWaitsForLock() {
+        $this->object->enableStampedeProtection(1, 60, 0.0);
+        $this->object->add('stampede' . AbstractStorage::LOCK_SUFFIX, 1, time() + 1);
+
+        // Nothing to serve, so wait for the lock holder, then recompute once the lock times out
+        $this->assertEquals('fresh', $this->object->store('stampede', () ==> 'fresh'));
+    }
+
+    public function testStoreStampedeWaitIsBounded() {
+        $this->object->enableStampedeProtection(30, 60, 0.0, 1);
+        $this->object->add('stampede' . AbstractStorage::LOCK_SUFFIX, 'other', time() + 30);
+
+        $start = microtime(true);
+
+        // The lock holder did not finish within the wait, so the value is computed but not persisted
+        $this->assertEquals('fresh', $this->object->store('stampede', () ==> 'fresh'));
+        $this->assertLessThan(3, microtime(true) - $start);
+        $this->assertFalse($this->object->has('stampede'));
+        $this->assertEquals('other', $this->object->get('stampede' . AbstractStorage::LOCK_SUFFIX));
+    }
+
+    public function testStoreStampedeKeepsLockOfOtherOwner() {
+        $this->object->enableStampedeProtection(5, 60, 0.0);
+
+        $this->object->store('stampede', function() {
+            // The lock expired and was acquired by another process
+            $this->object->set('stampede' . AbstractStorage::LOCK_SUFFIX, 'other', time() + 5);
+
+            return 'fresh';
+        });
+
+        $this->assertEquals('other', $this->object->get('stampede' . AbstractStorage::LOCK_SUFFIX));
+    }
+
+    public function testStoreStampedeProtectionDisabled() {
+        $this->assertEquals(null, $this->object->getStampedeProtection());
+
+        $this->object->enableStampedeProtection(10, 20, 0.5);
+
+        $this->assertEquals(shape('lock' => 10, 'grace' => 20, 'beta' => 0.5, 'wait' => 1), $this->object->getStampedeProtection());
+
+        // The wait is capped by the lock
+        $this->object->enableStampedeProtection(2, 20, 0.5, 5);
+
+        $this->assertEquals(2, $this->object->getStampedeProtection()['wait']);
+
+        $this->object->disableStampedeProtection();
+        $this->object->store('unprotected', () ==> 'value');
+
+        $this->assertFalse($this->object->has('unprotected' . AbstractStorage::META_SUFFIX));
+    }
+
+    public function testStoreWithTags() {
+        $count = 0;
+        $callback = function() use (&$count) {
+            $count++;
+
+            return 'tagged';
+        };
+
+        $this->assertEquals('tagged', $this->object->store('storeTagged', $callback, '+5 minutes', ['posts.1']));
+        $this->assertEquals('tagged', $this->object->store('storeTagged', $callback, '+5 minutes', ['posts.1']));
+        $this->assertEquals(1, $count);
+
+        $this->object->invalidateTags(['posts']);
+
+        $this->assertEquals('tagged', $this->object->store('storeTagged', $callback, '+5 minutes', ['posts.1']));
+        $this->assertEquals(2, $count);
+    }
+
+    public function testStoreWithTagsInvalidatedDuringCallback() {
+        $callback = function() {
+            $this->object->invalidateTags(['posts']); // Written by another process while computing
+
+            return 'stale';
+        };
+
+        $this->assertEquals('stale', $this->object->store('storeStale', $callback, '+5 minutes', ['posts.1']));
+        $this->assertFalse($this->object->has('storeStale'));
+
+        $this->object->enableStampedeProtection(5, 60, 0.0);
+
+        $this->assertEquals('stale', $this->object->store('storeStaleProtected', $callback, '+5 minutes', ['posts.1']));
+        $this->assertFalse($this->object->has('storeStaleProtected'));
+    }
+
+    public function testTryGet() {
+        $this->assertEquals(new HitItem('foo', ['username' => 'Titon']), $this->object->tryGet('foo'));
+        $this->assertEquals(new HitItem('count', 1), $this->object->tryGet('count'));
+    }
+
+    public function testTryGetMissingKey() {
+        $this->assertSame(null, $this->object->tryGet('bar')); // Expired
+        $this->assertSame(null, $this->object->tryGet('foobar'));
+    }
+
 }
\ No newline at end of file
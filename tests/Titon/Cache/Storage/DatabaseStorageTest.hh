@@ -24,4 +24,27 @@ class DatabaseStorageTest extends AbstractStorageTest {
         $this->unloadFixtures('Cache');
     }
 
+    public function testCompressionIsEncoded() {
+        $this->object->setCompression(100);
+
+        $template = str_repeat('<div class="item">Titon</div>', 100);
+
+        $this->object->set('template', $template, strtotime('+5 minutes'));
+
+        $value = $this->object->find('template')->first()->value;
+
+        $this->assertNotEquals(false, base64_decode($value, true));
+        $this->assertEquals($template, $this->object->get('template'));
+    }
+
+    public function testLegacyValues() {
+        (new Cache())->create([
+            'key' => 'legacy',
+            'value' => serialize(['foo' => 'bar']),
+            'expires_at' => date('Y-m-d H:i:s', strtotime('+5 minutes'))
+        ]);
+
+        $this->assertEquals(['foo' => 'bar'], $this->object->get('legacy'));
+    }
+
 }
\ No newline at end of file
@@ -1,6 +1,9 @@
 <?php
 namespace Titon\Cache\Storage;
 
+use Titon\Cache\Item;
+use Titon\Cache\Serializer;
+
 class FileSystemStorageTest extends AbstractStorageTest {
 
     protected function setUp() {
@@ -20,21 +23,126 @@ class FileSystemStorageTest extends AbstractStorageTest {
     }
 
     public function testFlush() {
-        $this->assertFileExists($this->vfs->path('/cache/foo.cache'));
+        $this->assertFileExists($this->object->getPath('foo'));
 
         $this->object->flush();
 
-        $this->assertFileNotExists($this->vfs->path('/cache/foo.cache'));
+        $this->assertFileNotExists($this->object->getPath('foo'));
+    }
+
+    public function testGetPath() {
+        $hash = md5('foo');
+
+        $this->assertEquals($this->vfs->path('/cache/' . substr($hash, 0, 2) . '/' . substr($hash, 2, 2) . '/' . $hash . '.cache'), $this->object->getPath('foo'));
+        $this->assertNotEquals($this->object->getPath('a:b'), $this->object->getPath('a-b'));
+    }
+
+    public function testFileFormat() {
+        $expires = strtotime('+5 minutes');
+        $data = chr(Serializer::PHP) . serialize(['username' => 'Titon']);
+
+        $this->object->set('foo', ['username' => 'Titon'], $expires);
+
+        $contents = file_get_contents($this->object->getPath('foo'));
+
+        $this->assertEquals(FileSystemStorage::HEADER_SIZE + strlen($data), strlen($contents));
+        $this->assertEquals([
+            'magic' => FileSystemStorage::MAGIC,
+            'expires' => $expires,
+            'size' => strlen($data),
+            'checksum' => crc32($data)
+        ], unpack('a4magic/Nexpires/Nsize/Nchecksum', substr($contents, 0, FileSystemStorage::HEADER_SIZE)));
+        $this->assertEquals($data, substr($contents, FileSystemStorage::HEADER_SIZE));
+    }
+
+    public function testFileFormatCompressed() {
+        $template = str_repeat('<div class="item">Titon</div>', 100);
+
+        $this->object->setCompression(100);
+        $this->object->set('template', $template, strtotime('+5 minutes'));
+
+        $data = substr(file_get_contents($this->object->getPath('template')), FileSystemStorage::HEADER_SIZE);
+
+        $this->assertEquals(chr(Serializer::RAW | Serializer::COMPRESSED), $data[0]);
+        $this->assertLessThan(strlen($template), strlen($data));
+        $this->assertEquals($template, gzuncompress(substr($data, 1)));
+    }
+
+    public function testFileFormatTagged() {
+        $this->object->save((new Item('tagged', 'value', '+5 minutes'))->setTags(['posts']));
+
+        $contents = file_get_contents($this->object->getPath('tagged'));
+
+        $this->assertEquals(FileSystemStorage::TAGGED_MAGIC, substr($contents, 0, 4));
+        $this->assertTrue($this->object->has('tagged'));
+
+        $this->object->invalidateTags(['posts']);
+
+        $this->assertFalse($this->object->has('tagged'));
+    }
+
+    public function testSetLeavesNoTempFiles() {
+        $this->object->set('foo', 'bar', strtotime('+5 minutes'));
+
+        $this->assertEquals([basename($this->object->getPath('foo'))], array_values(array_diff(scandir(dirname($this->object->getPath('foo'))), ['.', '..'])));
+    }
+
+    public function testTornFileIsMiss() {
+        $path = $this->object->getPath('foo');
+
+        file_put_contents($path, substr(file_get_contents($path), 0, -3));
+
+        $this->assertSame(null, $this->object->tryGet('foo'));
+    }
+
+    public function testCorruptFileIsMiss() {
+        $path = $this->object->getPath('foo');
+        $contents = file_get_contents($path);
+        $contents[strlen($contents) - 2] = 'X';
+
+        file_put_contents($path, $contents);
+
+        $this->assertSame(null, $this->object->tryGet('foo'));
+    }
+
+    public function testLegacyFileIsMiss() {
+        file_put_contents($this->object->getPath('foo'), strtotime('+5 minutes') . "\n" . serialize('legacy'));
+
+        $this->assertFalse($this->object->has('foo'));
+        $this->assertSame(null, $this->object->tryGet('foo'));
+    }
+
+    public function testAddRemovesOldInvalidFile() {
+        $path = $this->object->getPath('lock');
+
+        mkdir(dirname($path), 0755, true);
+        file_put_contents($path, '');
+
+        // A recent file may still be written
+        $this->assertFalse($this->object->add('lock', 1, strtotime('+5 minutes')));
+
+        touch($path, time() - 60);
+
+        $this->assertTrue($this->object->add('lock', 1, strtotime('+5 minutes')));
+        $this->assertEquals(1, $this->object->get('lock'));
+    }
+
+    public function testAddReplacesExpiredFile() {
+        $this->object->set('lock', 1, time() - 1);
+
+        $this->assertTrue($this->object->add('lock', 2, strtotime('+5 minutes')));
+        $this->assertFalse($this->object->add('lock', 3, strtotime('+5 minutes')));
+        $this->assertEquals(2, $this->object->get('lock'));
     }
 
     public function testRemove() {
         $this->assertTrue($this->object->has('foo'));
-        $this->assertFileExists($this->vfs->path('/cache/foo.cache'));
+        $this->assertFileExists($this->object->getPath('foo'));
 
         $this->object->remove('foo');
 
         $this->assertFalse($this->object->has('foo'));
-        $this->assertFileNotExists($this->vfs->path('/cache/foo.cache'));
+        $this->assertFileNotExists($this->object->getPath('foo'));
     }
 
-}
\ No newline at end of file
+}
@@ -1,6 +1,9 @@
 <?hh
 namespace Titon\Cache\Storage;
 
+use Titon\Cache\HitItem;
+use Titon\Cache\Item;
+use Titon\Cache\MissItem;
 use \Memcached;
 
 class MemcacheStorageTest extends AbstractStorageTest {
@@ -29,4 +32,36 @@ class MemcacheStorageTest extends AbstractStorageTest {
         parent::setUp();
     }
 
+    public function testGetItemsSingleRoundTrip() {
+        $memcache = $this->getMock('Memcached', ['get', 'getMulti']);
+        $memcache->expects($this->never())->method('get');
+        $memcache->expects($this->once())
+            ->method('getMulti')
+            ->with(['foo', 'bar'])
+            ->will($this->returnValue(['foo' => ['username' => 'Titon']]));
+
+        $this->assertEquals(Map {
+            'foo' => new HitItem('foo', ['username' => 'Titon']),
+            'bar' => new MissItem('bar')
+        }, (new MemcacheStorage($memcache))->getItems(['foo', 'bar']));
+    }
+
+    public function testCommitBatchedPerExpiration() {
+        $expires = strtotime('+5 minutes');
+
+        $memcache = $this->getMock('Memcached', ['set', 'setMulti']);
+        $memcache->expects($this->never())->method('set');
+        $memcache->expects($this->once())
+            ->method('setMulti')
+            ->with(['baz' => 123, 'qux' => 456], $expires)
+            ->will($this->returnValue(true));
+
+        $storage = new MemcacheStorage($memcache);
+        $storage->saveDeferred(new Item('baz', 123, new \DateTime('@' . $expires)));
+        $storage->saveDeferred(new Item('qux', 456, new \DateTime('@' . $expires)));
+
+        $this->assertTrue($storage->commit());
+        $this->assertEquals(Vector {}, $storage->getDeferred());
+    }
+
 }
\ No newline at end of file
@@ -1,6 +1,9 @@
 <?hh
 namespace Titon\Cache\Storage;
 
+use Titon\Cache\Item;
+use Titon\Cache\Storage;
+
 class MemoryStorageTest extends AbstractStorageTest {
 
     protected function setUp() {
@@ -9,4 +12,99 @@ class MemoryStorageTest extends AbstractStorageTest {
         parent::setUp();
     }
 
-}
\ No newline at end of file
+    public function testExpiration() {
+        $this->object->set('expired', 123, time() - 1);
+        $this->object->set('forever', 456, 0);
+
+        $this->assertFalse($this->object->has('expired'));
+        $this->assertSame(null, $this->object->tryGet('expired'));
+        $this->assertTrue($this->object->has('forever'));
+    }
+
+    public function testPurge() {
+        $this->object->set('expired1', 123, time() - 1);
+        $this->object->set('expired2', 456, time() - 10);
+
+        $this->assertEquals(2, $this->object->purge());
+        $this->assertEquals(2, $this->object->stats()[Storage::ITEMS]); // foo, count
+    }
+
+    public function testCommitDeferredReadsTagVersionsOnce() {
+        $this->object->invalidateTags(['user', 'user.1', 'user.2']);
+
+        $this->object->saveDeferred((new Item('a', 'A', '+5 minutes'))->setTags(['user.1']));
+        $this->object->saveDeferred((new Item('b', 'B', '+5 minutes'))->setTags(['user.2']));
+        $this->object->saveDeferred((new Item('c', 'C', '+5 minutes'))->setTags(['user']));
+
+        $hits = $this->object->stats()[Storage::HITS];
+
+        $this->object->commit();
+
+        // Each of the 3 versions is read once, instead of once per item and namespace
+        $this->assertEquals($hits + 3, $this->object->stats()[Storage::HITS]);
+    }
+
+    public function testMaxItemsEvictsLeastRecentlyUsed() {
+        $storage = new MemoryStorage(3);
+        $expires = strtotime('+5 minutes');
+
+        $storage->set('a', 1, $expires);
+        $storage->set('b', 2, $expires);
+        $storage->set('c', 3, $expires);
+
+        $storage->getItem('a'); // Now b is the least recently used
+
+        $storage->set('d', 4, $expires);
+
+        $this->assertTrue($storage->has('a'));
+        $this->assertFalse($storage->has('b'));
+        $this->assertTrue($storage->has('c'));
+        $this->assertTrue($storage->has('d'));
+        $this->assertEquals(1, $storage->stats()[Storage::EVICTIONS]);
+    }
+
+    public function testMaxSizeEvictsLeastRecentlyUsed() {
+        $storage = new MemoryStorage(0, 100);
+        $expires = strtotime('+5 minutes');
+        $value = str_repeat('x', 30); // 1 byte key + 38 bytes serialized
+
+        $storage->set('a', $value, $expires);
+        $storage->set('b', $value, $expires);
+
+        $this->assertEquals(78, $storage->stats()[Storage::MEMORY_USAGE]);
+
+        $storage->set('c', $value, $expires);
+
+        $this->assertFalse($storage->has('a'));
+        $this->assertTrue($storage->has('b'));
+        $this->assertTrue($storage->has('c'));
+        $this->assertEquals(78, $storage->stats()[Storage::MEMORY_USAGE]);
+        $this->assertEquals(22, $storage->stats()[Storage::MEMORY_AVAILABLE]);
+    }
+
+    public function testSetLargerThanMaxSize() {
+        $storage = new MemoryStorage(0, 10);
+
+        $this->assertFalse($storage->set('a', str_repeat('x', 20), 0));
+        $this->assertFalse($storage->has('a'));
+
+        // The previous value is not served as stale
+        $this->assertTrue($storage->set('b', 'x', 0));
+        $this->assertFalse($storage->set('b', str_repeat('x', 20), 0));
+        $this->assertFalse($storage->has('b'));
+    }
+
+    public function testStatsCounters() {
+        $this->object->getItem('foo');
+        $this->object->getItem('count');
+        $this->object->getItem('missing');
+
+        $stats = $this->object->stats();
+
+        $this->assertEquals(2, $stats[Storage::HITS]);
+        $this->assertEquals(1, $stats[Storage::MISSES]);
+        $this->assertEquals(0, $stats[Storage::EVICTIONS]);
+        $this->assertEquals(2, $stats[Storage::ITEMS]);
+    }
+
+}
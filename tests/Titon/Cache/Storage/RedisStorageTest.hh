@@ -1,6 +1,9 @@
 <?hh
 namespace Titon\Cache\Storage;
 
+use Titon\Cache\HitItem;
+use Titon\Cache\Item;
+use Titon\Cache\MissItem;
 use \Redis;
 
 class RedisStorageTest extends AbstractStorageTest {
@@ -23,4 +26,32 @@ class RedisStorageTest extends AbstractStorageTest {
         parent::setUp();
     }
 
+    public function testGetItemsSingleRoundTrip() {
+        $redis = $this->getMock('Redis', ['get', 'mget']);
+        $redis->expects($this->never())->method('get');
+        $redis->expects($this->once())
+            ->method('mget')
+            ->with(['foo', 'bar'])
+            ->will($this->returnValue([serialize(['username' => 'Titon']), false]));
+
+        $this->assertEquals(Map {
+            'foo' => new HitItem('foo', ['username' => 'Titon']),
+            'bar' => new MissItem('bar')
+        }, (new RedisStorage($redis))->getItems(['foo', 'bar']));
+    }
+
+    public function testCommitPipelined() {
+        $redis = $this->getMock('Redis', ['setex', 'multi', 'exec']);
+        $redis->expects($this->once())->method('multi')->with(Redis::PIPELINE)->will($this->returnSelf());
+        $redis->expects($this->exactly(2))->method('setex')->will($this->returnSelf());
+        $redis->expects($this->once())->method('exec')->will($this->returnValue([true, true]));
+
+        $storage = new RedisStorage($redis);
+        $storage->saveDeferred(new Item('baz', 123));
+        $storage->saveDeferred(new Item('qux', 456, '+5 minutes'));
+
+        $this->assertTrue($storage->commit());
+        $this->assertEquals(Vector {}, $storage->getDeferred());
+    }
+
 }
\ No newline at end of file
@@ -0,0 +1,148 @@
+<?hh
+namespace Titon\Cache\Storage;
+
+use Titon\Cache\Storage;
+
+/**
+ * @property \Titon\Cache\Storage\TieredStorage $object
+ */
+class TieredStorageTest extends AbstractStorageTest {
+
+    protected MemoryStorage $l1;
+
+    protected MemoryStorage $l2;
+
+    protected function setUp() {
+        $this->l1 = new MemoryStorage();
+        $this->l2 = new MemoryStorage();
+        $this->object = new TieredStorage($this->l1, $this->l2, 5, 0);
+
+        parent::setUp();
+    }
+
+    public function testWriteThrough() {
+        $this->object->set('key', 'value', strtotime('+5 minutes'));
+
+        $this->assertEquals('value', $this->l2->get('key'));
+        $this->assertEquals(shape('generation' => 0, 'value' => 'value'), $this->l1->get('key'));
+    }
+
+    public function testReadThrough() {
+        $this->l2->set('key', 'value', strtotime('+5 minutes'));
+
+        $this->assertFalse($this->l1->has('key'));
+        $this->assertEquals('value', $this->object->get('key'));
+        $this->assertTrue($this->l1->has('key'));
+    }
+
+    public function testL1TtlIsShort() {
+        $this->object->set('key', 'value', strtotime('+5 minutes'));
+        $this->object->set('soon', 'value', time() + 2);
+
+        $this->assertLessThanOrEqual(time() + 5, $this->getL1Expires('key'));
+        $this->assertLessThanOrEqual(time() + 2, $this->getL1Expires('soon'));
+    }
+
+    public function testGenerationInvalidatesOtherProcesses() {
+        $other = new TieredStorage(new MemoryStorage(), $this->l2, 5, 0);
+
+        $this->assertEquals(['username' => 'Titon'], $other->get('foo'));
+
+        // Written directly to L2, so the L1 of the other process is stale
+        $this->l2->set('foo', ['username' => 'Changed'], strtotime('+5 minutes'));
+
+        $this->assertEquals(['username' => 'Titon'], $other->get('foo'));
+
+        $this->object->invalidate();
+
+        $this->assertEquals(['username' => 'Changed'], $other->get('foo'));
+        $this->assertEquals(1, $other->getGeneration());
+    }
+
+    public function testConcurrentInvalidationsAreNotLost() {
+        $first = new TieredStorage(new MemoryStorage(), $this->l2, 5, 60);
+        $second = new TieredStorage(new MemoryStorage(), $this->l2, 5, 60);
+
+        // Both processes have cached the generation
+        $this->assertEquals(0, $first->getGeneration());
+        $this->assertEquals(0, $second->getGeneration());
+
+        $this->assertEquals(1, $first->invalidate());
+        $this->assertEquals(2, $second->invalidate());
+        $this->assertEquals(2, $this->object->getGeneration());
+    }
+
+    public function testInvalidateSkipsClaimedGenerations() {
+        $this->l2->add(TieredStorage::GENERATION_KEY . '.1', 1, strtotime('+5 minutes'));
+
+        $this->assertEquals(2, $this->object->invalidate());
+    }
+
+    public function testRemoveInvalidatesOtherProcesses() {
+        $other = new TieredStorage(new MemoryStorage(), $this->l2, 5, 0);
+
+        $this->assertTrue($other->has('foo'));
+
+        $this->object->remove('foo');
+
+        $this->assertFalse($other->has('foo'));
+    }
+
+    public function testFlushKeepsGeneration() {
+        $this->object->invalidate();
+        $this->object->flush();
+
+        $this->assertEquals(2, $this->object->getGeneration());
+        $this->assertFalse($this->object->has('foo'));
+    }
+
+    public function testGetItemsBatchesL1Misses() {
+        $this->l1->flush();
+
+        $this->object->get('foo'); // Read through into L1
+
+        $items = $this->object->getItems(['foo', 'count', 'missing']);
+
+        $this->assertTrue($items['foo']->isHit());
+        $this->assertTrue($items['count']->isHit());
+        $this->assertFalse($items['missing']->isHit());
+
+        $stats = $this->object->stats();
+
+        $this->assertEquals(1, $stats[TieredStorage::L1][Storage::HITS]);
+        $this->assertEquals(2, $stats[TieredStorage::L2][Storage::HITS]);
+        $this->assertEquals(1, $stats[TieredStorage::L2][Storage::MISSES]);
+    }
+
+    public function testStatsPerTier() {
+        $this->l1->flush();
+
+        $this->object->get('foo'); // L1 miss, L2 hit
+        $this->object->get('foo'); // L1 hit
+        $this->object->getItem('missing'); // L1 miss, L2 miss
+
+        $this->assertEquals(Map {
+            Storage::HITS => 2,
+            Storage::MISSES => 1,
+            TieredStorage::HIT_RATIO => 0.6667,
+            TieredStorage::L1 => Map {
+                Storage::HITS => 1,
+                Storage::MISSES => 2,
+                TieredStorage::HIT_RATIO => 0.3333
+            },
+            TieredStorage::L2 => Map {
+                Storage::HITS => 1,
+                Storage::MISSES => 1,
+                TieredStorage::HIT_RATIO => 0.5
+            }
+        }, $this->object->stats());
+    }
+
+    protected function getL1Expires(string $key): int {
+        $entries = (new \ReflectionProperty($this->l1, '_entries'));
+        $entries->setAccessible(true);
+
+        return $entries->getValue($this->l1)[$key]['expires'];
+    }
+
+}
@@ -0,0 +1,39 @@
+<?hh
+namespace Titon\Cache;
+
+use Titon\Test\TestCase;
+
+/**
+ * @property \Titon\Cache\TaggedValue $object
+ */
+class TaggedValueTest extends TestCase {
+
+    protected function setUp() {
+        parent::setUp();
+
+        $this->object = new TaggedValue('foo', Map {'user' => 1, 'user.5' => 2});
+    }
+
+    public function testGetValue() {
+        $this->assertEquals('foo', $this->object->getValue());
+    }
+
+    public function testGetTagsAndVersions() {
+        $this->assertEquals(['user', 'user.5'], $this->object->getTags());
+        $this->assertEquals(Map {'user' => 1, 'user.5' => 2}, $this->object->getVersions());
+    }
+
+    public function testIsCurrent() {
+        $this->assertTrue($this->object->isCurrent(Map {'user' => 1, 'user.5' => 2, 'posts' => 3}));
+        $this->assertFalse($this->object->isCurrent(Map {'user' => 1, 'user.5' => 3}));
+        $this->assertFalse($this->object->isCurrent(Map {'user' => 1}));
+    }
+
+    public function testSurvivesSerialization() {
+        $value = unserialize(serialize($this->object));
+
+        $this->assertEquals('foo', $value->getValue());
+        $this->assertTrue($value->isCurrent(Map {'user' => 1, 'user.5' => 2}));
+    }
+
+}
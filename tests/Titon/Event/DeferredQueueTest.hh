@@ -0,0 +1,140 @@
+<?hh
+namespace Titon\Event;
+
+use Psr\Log\AbstractLogger;
+use Titon\Test\TestCase;
+
+/**
+ * @property \Titon\Event\DeferredQueue $object
+ * @property \Titon\Event\Emitter $emitter
+ */
+class DeferredQueueTest extends TestCase {
+
+    protected function setUp() {
+        parent::setUp();
+
+        $this->object = new DeferredQueue(3);
+        $this->emitter = new Emitter();
+    }
+
+    public function testDispatchInOrder() {
+        $list = [];
+
+        $this->emitter->register('event.foo', function(Event $event, $value) use (&$list) { $list[] = 'foo' . $value; });
+        $this->emitter->register('event.bar', function(Event $event, $value) use (&$list) { $list[] = 'bar' . $value; });
+
+        $this->object->push($this->emitter, 'event.foo', [1]);
+        $this->object->push($this->emitter, 'event.bar', [2]);
+        $this->object->push($this->emitter, 'event.foo', [3]);
+
+        $this->assertEquals([], $list);
+        $this->assertEquals(3, $this->object->count());
+
+        $events = $this->object->dispatch();
+
+        $this->assertEquals(['foo1', 'bar2', 'foo3'], $list);
+        $this->assertEquals(3, count($events));
+        $this->assertEquals('event.bar', $events[1]->getKey());
+        $this->assertEquals(0, $this->object->count());
+    }
+
+    public function testDispatchEventsQueuedDuringDispatch() {
+        $list = [];
+        $queue = $this->object;
+        $emitter = $this->emitter;
+
+        $emitter->register('event.foo', function(Event $event) use (&$list, $queue, $emitter) {
+            $list[] = 'foo';
+            $queue->push($emitter, 'event.bar', []);
+        });
+        $emitter->register('event.bar', function(Event $event) use (&$list) { $list[] = 'bar'; });
+
+        $this->object->push($emitter, 'event.foo', []);
+        $this->object->push($emitter, 'event.baz', []);
+        $this->object->dispatch();
+
+        $this->assertEquals(['foo', 'bar'], $list);
+    }
+
+    public function testDispatchLimitsPasses() {
+        $count = 0;
+        $queue = $this->object;
+        $emitter = $this->emitter;
+
+        // Every observer defers the event again
+        $emitter->register('event.foo', function(Event $event) use (&$count, $queue, $emitter) {
+            $count++;
+            $queue->push($emitter, 'event.foo', []);
+        });
+
+        $this->object->push($emitter, 'event.foo', []);
+
+        $this->assertEquals(DeferredQueue::MAX_PASSES, count($this->object->dispatch()));
+        $this->assertEquals(DeferredQueue::MAX_PASSES, $count);
+        $this->assertEquals(1, $this->object->count());
+    }
+
+    public function testDispatchLogsExceptions() {
+        $list = [];
+        $logger = new DeferredLoggerStub();
+
+        $this->emitter->register('event.foo', function(Event $event) { throw new \Exception('Failed'); });
+        $this->emitter->register('event.bar', function(Event $event) use (&$list) { $list[] = 'bar'; });
+
+        $this->object->setLogger($logger);
+        $this->object->push($this->emitter, 'event.foo', []);
+        $this->object->push($this->emitter, 'event.bar', []);
+
+        $this->assertEquals(1, count($this->object->dispatch()));
+        $this->assertEquals(['bar'], $list);
+        $this->assertEquals(['Deferred event event.foo failed: Failed'], $logger->messages);
+    }
+
+    public function testCapacity() {
+        $this->assertTrue($this->object->push($this->emitter, 'event.foo', []));
+        $this->assertTrue($this->object->push($this->emitter, 'event.foo', []));
+        $this->assertTrue($this->object->push($this->emitter, 'event.foo', []));
+        $this->assertFalse($this->object->push($this->emitter, 'event.foo', []));
+
+        $this->assertEquals(3, $this->object->getCapacity());
+        $this->assertEquals(3, $this->object->count());
+        $this->assertEquals(1, $this->object->getDropped());
+
+        $this->object->flush();
+
+        $this->assertEquals(0, $this->object->count());
+        $this->assertEquals(0, $this->object->getDropped());
+    }
+
+    public function testCoalesce() {
+        $list = [];
+        $other = new Emitter();
+
+        $this->emitter->register('event.foo', function(Event $event, $value) use (&$list) { $list[] = 'foo' . $value; });
+        $this->emitter->register('event.bar', function(Event $event, $value) use (&$list) { $list[] = 'bar' . $value; });
+        $other->register('event.foo', function(Event $event, $value) use (&$list) { $list[] = 'other' . $value; });
+
+        $this->object->push($this->emitter, 'event.foo', [1], true);
+        $this->object->push($this->emitter, 'event.bar', [2], true);
+        $this->object->push($other, 'event.foo', [3], true);
+
+        // Full, but coalesced events replace the queued params
+        $this->assertTrue($this->object->push($this->emitter, 'event.foo', [4], true));
+        $this->assertFalse($this->object->push($this->emitter, 'event.baz', [5], true));
+
+        $this->assertEquals(3, $this->object->count());
+
+        $this->object->dispatch();
+
+        $this->assertEquals(['foo4', 'bar2', 'other3'], $list);
+    }
+
+}
+
+class DeferredLoggerStub extends AbstractLogger {
+    public array<string> $messages = [];
+
+    public function log($level, $message, array $context = []) {
+        $this->messages[] = $message;
+    }
+}
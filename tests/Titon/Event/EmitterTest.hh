@@ -39,8 +39,8 @@ class EmitterTest extends TestCase {
 
         $this->assertEquals(Vector {}, $this->object->getObservers('event.foobar'));
         $this->assertEquals(Vector {
-            new Observer($ob1, 20, false),
             new Observer($ob2, 15, false),
+            new Observer($ob1, 20, false),
         }, $this->object->getObservers('event.test'));
     }
 
@@ -82,13 +82,8 @@ class EmitterTest extends TestCase {
         $this->object->register('event.test', $ob3, 20);
 
         $this->assertEquals(Vector {}, $this->object->getObservers('event.foobar'));
-        $this->assertEquals(Vector {
-            new Observer($ob1, 20, false),
-            new Observer($ob2, 15, false),
-            new Observer($ob3, 20, false),
-        }, $this->object->getObservers('event.test'));
 
-        // Sorted
+        // Sorted on registration, equal priorities keep their order
         $this->assertEquals(Vector {
             new Observer($ob2, 15, false),
             new Observer($ob1, 20, false),
@@ -96,12 +91,54 @@ class EmitterTest extends TestCase {
         }, $this->object->getSortedObservers('event.test'));
     }
 
+    public function testGetCallStackCacheIsInvalidated() {
+        $ob1 = function(Event $event) { };
+        $ob2 = [new ListenerStub(), 'noop1'];
+        $ob3 = [new ListenerStub(), 'noop2'];
+
+        $this->object->register('event.test', $ob1, 20);
+
+        $stack = $this->object->getCallStack('event.test');
+
+        $this->assertEquals(Vector {'{closure}'}, $stack);
+        $this->assertSame($stack, $this->object->getCallStack('event.test'));
+
+        // Register
+        $this->object->register('event.test', $ob2, 10);
+        $this->object->register('event.test', $ob3, 30);
+
+        $this->assertEquals(Vector {
+            'Titon\Event\ListenerStub::noop1',
+            '{closure}',
+            'Titon\Event\ListenerStub::noop2'
+        }, $this->object->getCallStack('event.test'));
+
+        // Remove
+        $this->object->remove('event.test', $ob1);
+
+        $this->assertEquals(Vector {
+            'Titon\Event\ListenerStub::noop1',
+            'Titon\Event\ListenerStub::noop2'
+        }, $this->object->getCallStack('event.test'));
+
+        // Flush
+        $this->object->flush('event.test');
+
+        $this->assertEquals(Vector {}, $this->object->getCallStack('event.test'));
+    }
+
     public function testHasObservers() {
         $this->assertFalse($this->object->hasObservers('event.test'));
 
-        $this->object->register('event.test', function(Event $event) { });
+        $ob1 = function(Event $event) { };
+
+        $this->object->register('event.test', $ob1);
 
         $this->assertTrue($this->object->hasObservers('event.test'));
+
+        $this->object->remove('event.test', $ob1);
+
+        $this->assertFalse($this->object->hasObservers('event.test'));
     }
 
     public function testAsyncGetObservers() {
@@ -189,6 +226,36 @@ class EmitterTest extends TestCase {
         $this->assertEquals(Vector {}, $this->object->getCallStack('event.test1'));
     }
 
+    public function testRegisterWiring() {
+        $listener = new ListenerStub();
+        $sequential = new Emitter();
+
+        $this->object->register('event.test1', function(Event $event) { }, 50);
+        $sequential->register('event.test1', function(Event $event) { }, 50);
+
+        $this->object->registerWiring($listener, Vector {
+            shape('event' => 'event.test1', 'method' => 'noop1', 'priority' => 0, 'once' => false, 'async' => false),
+            shape('event' => 'event.test1', 'method' => 'noop2', 'priority' => 45, 'once' => true, 'async' => false),
+            shape('event' => 'event.test1', 'method' => 'noop3', 'priority' => 50, 'once' => false, 'async' => false),
+            shape('event' => 'event.test2', 'method' => 'asyncNoop1', 'priority' => 0, 'once' => false, 'async' => true)
+        });
+
+        $sequential->register('event.test1', inst_meth($listener, 'noop1'));
+        $sequential->register('event.test1', inst_meth($listener, 'noop2'), 45, true);
+        $sequential->register('event.test1', inst_meth($listener, 'noop3'), 50);
+        $sequential->register('event.test2', inst_meth($listener, 'asyncNoop1'));
+
+        $this->assertEquals($sequential->getObservers('event.test1'), $this->object->getObservers('event.test1'));
+        $this->assertEquals($sequential->getObservers('event.test2'), $this->object->getObservers('event.test2'));
+        $this->assertEquals(Vector {
+            'Titon\Event\ListenerStub::noop2',
+            '{closure}',
+            'Titon\Event\ListenerStub::noop3',
+            'Titon\Event\ListenerStub::noop1'
+        }, $this->object->getCallStack('event.test1'));
+        $this->assertTrue($this->object->getObservers('event.test2')[0]->isAsync());
+    }
+
     public function testEmit() {
         $ob1 = function(Event $event) { };
         $ob2 = function(Event $event) { $event->stop(); };
@@ -204,10 +271,42 @@ class EmitterTest extends TestCase {
         $this->assertEquals(1, $event->getIndex());
     }
 
+    public function testEmitOnce() {
+        $count = 0;
+        $ob1 = function(Event $event) use (&$count) { $count++; };
+        $ob2 = function(Event $event) use (&$count) { $count += 10; };
+
+        $this->object->register('event.test', $ob1, 0, true);
+        $this->object->register('event.test', $ob2);
+
+        $this->assertEquals(2, count($this->object->emit('event.test', [])->getCallStack()));
+        $this->assertEquals(11, $count);
+
+        $this->assertEquals(1, count($this->object->emit('event.test', [])->getCallStack()));
+        $this->assertEquals(21, $count);
+    }
+
     public function testEmitNoObservers() {
         $event = $this->object->emit('fake.event', []);
 
         $this->assertInstanceOf('Titon\Event\Event', $event);
+        $this->assertEquals('fake.event', $event->getKey());
+        $this->assertEquals(Vector {}, $event->getCallStack());
+        $this->assertEquals(0, $event->getIndex());
+        $this->assertFalse($event->isStopped());
+    }
+
+    public function testEmitRemovedObservers() {
+        $count = 0;
+        $ob1 = function(Event $event) use (&$count) { $count++; };
+
+        $this->object->register('event.test', $ob1);
+        $this->object->emit('event.test', []);
+        $this->object->remove('event.test', $ob1);
+
+        $event = $this->object->emit('event.test', []);
+
+        $this->assertEquals(1, $count);
         $this->assertEquals(Vector {}, $event->getCallStack());
     }
 
@@ -275,6 +374,70 @@ class EmitterTest extends TestCase {
         $this->assertEquals(5, count($events));
     }
 
+    public function testEmitManyWildcardSkipsWildcardKeys() {
+        $this->object->register('view.rendered.template', function(Event $event) { });
+        $this->object->register('view.rendered.layout', function(Event $event) { });
+        $this->object->register('view.rendered.*', function(Event $event) { });
+
+        $this->assertEquals(Vector {'view.rendered.template', 'view.rendered.layout'}, $this->object->emitMany('view.rendered.*', [])->keys());
+    }
+
+    public function testWildcardObservers() {
+        $list = [];
+        $ob1 = function(Event $event) use (&$list) { $list[] = 'exact'; };
+        $ob2 = function(Event $event) use (&$list) { $list[] = 'wildcard'; };
+        $ob3 = function(Event $event) use (&$list) { $list[] = 'namespace'; };
+
+        $this->object->register('view.rendered.template', $ob1, 20);
+        $this->object->register('view.rendered.*', $ob2, 10);
+        $this->object->register('view.**', $ob3, 20);
+
+        $this->assertTrue($this->object->hasObservers('view.rendered.layout'));
+        $this->assertTrue($this->object->hasObservers('view.rendering'));
+        $this->assertFalse($this->object->hasObservers('controller.processing'));
+
+        $event = $this->object->emit('view.rendered.template', []);
+
+        $this->assertEquals(['wildcard', 'exact', 'namespace'], $list);
+        $this->assertEquals(3, count($event->getCallStack()));
+
+        $list = [];
+        $this->object->emit('view.rendering', []);
+
+        $this->assertEquals(['namespace'], $list);
+
+        // Removing a wildcard observer invalidates every event
+        $this->object->remove('view.**', $ob3);
+
+        $list = [];
+        $this->object->emit('view.rendered.template', []);
+
+        $this->assertEquals(['wildcard', 'exact'], $list);
+        $this->assertFalse($this->object->hasObservers('view.rendering'));
+
+        // Flushing a wildcard key
+        $this->object->flush('view.rendered.*');
+
+        $list = [];
+        $this->object->emit('view.rendered.template', []);
+
+        $this->assertEquals(['exact'], $list);
+    }
+
+    public function testWildcardObserversOnce() {
+        $count = 0;
+        $ob1 = function(Event $event) use (&$count) { $count++; };
+
+        $this->object->register('event.*', $ob1, 0, true);
+
+        $this->object->emit('event.test', []);
+        $this->object->emit('event.test', []);
+        $this->object->emit('event.other', []);
+
+        $this->assertEquals(1, $count);
+        $this->assertEquals(Vector {}, $this->object->getObservers('event.*'));
+    }
+
     public function testEmitAsyncs() {
         $stub = new ListenerStub();
         $list = [];
@@ -294,9 +457,168 @@ class EmitterTest extends TestCase {
         $this->assertNotEquals([1, 2, 3, 1, 2, 3], $list);
     }
 
+    public function testProfiler() {
+        $profiler = new Profiler();
+        $stub = new SlowListenerStub();
+
+        $this->assertEquals(null, Emitter::getProfiler());
+
+        Emitter::setProfiler($profiler);
+
+        $this->object->register('event.test', [new ListenerStub(), 'noop1']);
+        $this->object->register('event.test', [$stub, 'sleep50']);
+        $this->object->emit('event.test', []);
+        $this->object->emit('event.test', []);
+
+        Emitter::setProfiler(null);
+
+        $this->object->emit('event.test', []);
+
+        $metrics = $profiler->getMetrics('event.test')['event.test'];
+
+        $this->assertEquals(Vector {'Titon\Event\ListenerStub::noop1', 'Titon\Event\SlowListenerStub::sleep50'}, $metrics->keys());
+        $this->assertEquals(2, $metrics['Titon\Event\ListenerStub::noop1']['count']);
+        $this->assertEquals(2, $metrics['Titon\Event\SlowListenerStub::sleep50']['count']);
+        $this->assertGreaterThanOrEqual(0.1, $metrics['Titon\Event\SlowListenerStub::sleep50']['time']);
+    }
+
+    public function testAsyncLimits() {
+        $this->assertEquals(shape('concurrency' => 0, 'timeout' => 0, 'deadline' => 0), $this->object->getAsyncLimit('event.test'));
+
+        $this->object->setAsyncLimit('', 5);
+        $this->object->setAsyncLimit('event.test', 2, 100, -1);
+
+        $this->assertEquals(shape('concurrency' => 2, 'timeout' => 100, 'deadline' => 0), $this->object->getAsyncLimit('event.test'));
+        $this->assertEquals(shape('concurrency' => 5, 'timeout' => 0, 'deadline' => 0), $this->object->getAsyncLimit('event.other'));
+    }
+
+    public function testEmitAsyncConcurrency() {
+        $stub = new SlowListenerStub();
+
+        for ($i = 0; $i < 6; $i++) {
+            $this->object->register('event.test', [$stub, 'sleep50']);
+        }
+
+        $this->object->setAsyncLimit('event.test', 2);
+
+        $event = $this->object->emit('event.test', []);
+
+        $this->assertEquals(6, $stub->count);
+        $this->assertEquals(2, $stub->maxRunning);
+        $this->assertFalse($event->isTimedOut());
+    }
+
+    public function testEmitAsyncTimeout() {
+        $stub = new SlowListenerStub();
+
+        $this->object->register('event.test', [$stub, 'sleep50']);
+        $this->object->register('event.test', [$stub, 'sleep1000']);
+        $this->object->setAsyncLimit('event.test', 0, 200);
+
+        $start = microtime(true);
+        $event = $this->object->emit('event.test', []);
+
+        $this->assertLessThan(0.8, microtime(true) - $start);
+        $this->assertTrue($event->isTimedOut());
+        $this->assertEquals(Vector {'Titon\Event\SlowListenerStub::sleep1000'}, $event->getTimeouts());
+        $this->assertEquals(1, $event->getIndex());
+    }
+
+    public function testEmitAsyncTimeoutCountsAgainstConcurrency() {
+        $stub = new SlowListenerStub();
+
+        $this->object->register('event.test', [$stub, 'sleep150']);
+        $this->object->register('event.test', [$stub, 'sleep50']);
+        $this->object->setAsyncLimit('event.test', 1, 100);
+
+        $event = $this->object->emit('event.test', []);
+
+        // The second observer only starts once the timed out observer has finished
+        $this->assertEquals(Vector {'Titon\Event\SlowListenerStub::sleep150'}, $event->getTimeouts());
+        $this->assertEquals(2, $stub->count);
+        $this->assertEquals(1, $stub->maxRunning);
+    }
+
+    public function testEmitAsyncTimeoutDoesNotWaitForHungObserver() {
+        $stub = new SlowListenerStub();
+
+        $this->object->register('event.test', [$stub, 'hang']);
+        $this->object->register('event.test', [$stub, 'sleep50']);
+        $this->object->setAsyncLimit('event.test', 1, 100);
+
+        $start = microtime(true);
+        $event = $this->object->emit('event.test', []);
+
+        // The hung observer is waited on for another timeout, before the next observer starts
+        $this->assertLessThan(0.8, microtime(true) - $start);
+        $this->assertEquals(Vector {'Titon\Event\SlowListenerStub::hang'}, $event->getTimeouts());
+        $this->assertEquals(1, $stub->count);
+    }
+
+    public function testEmitAsyncDeadline() {
+        $stub = new SlowListenerStub();
+
+        $this->object->register('event.test', [$stub, 'sleep50']);
+        $this->object->register('event.test', [$stub, 'sleep1000']);
+        $this->object->register('event.test', [$stub, 'sleep50']);
+        $this->object->setAsyncLimit('event.test', 1, 0, 300);
+
+        $start = microtime(true);
+        $event = $this->object->emit('event.test', []);
+
+        $this->assertLessThan(0.8, microtime(true) - $start);
+
+        // The second observer exceeds the deadline, so the third never starts
+        $this->assertEquals(Vector {
+            'Titon\Event\SlowListenerStub::sleep1000',
+            'Titon\Event\SlowListenerStub::sleep50'
+        }, $event->getTimeouts());
+        $this->assertEquals(1, $stub->count);
+    }
+
+}
+
+class SlowListenerStub {
+
+    public int $count = 0;
+
+    public int $running = 0;
+
+    public int $maxRunning = 0;
+
+    public async function hang(Event $e): Awaitable<mixed> {
+        while (true) {
+            await SleepWaitHandle::create(10000);
+        }
+    }
+
+    public async function sleep50(Event $e): Awaitable<mixed> {
+        return await $this->sleep(50);
+    }
+
+    public async function sleep150(Event $e): Awaitable<mixed> {
+        return await $this->sleep(150);
+    }
+
+    public async function sleep1000(Event $e): Awaitable<mixed> {
+        return await $this->sleep(1000);
+    }
+
+    public async function sleep(int $ms): Awaitable<mixed> {
+        $this->running++;
+        $this->maxRunning = max($this->maxRunning, $this->running);
+
+        await SleepWaitHandle::create($ms * 1000);
+
+        $this->running--;
+        $this->count++;
+
+        return true;
+    }
+
 }
 
-class ListenerStub implements Listener {
+class ListenerStub implements StaticListener {
 
     public function registerEvents(): ListenerMap {
         return Map {
@@ -0,0 +1,78 @@
+<?hh
+namespace Titon\Event;
+
+use Titon\Test\TestCase;
+
+/**
+ * @property \Titon\Event\EventIndex $object
+ * @property \Titon\Event\EventIndex $wildcards
+ */
+class EventIndexTest extends TestCase {
+
+    protected function setUp() {
+        parent::setUp();
+
+        $this->object = new EventIndex();
+        $this->object
+            ->add('view.rendering.template')
+            ->add('view.rendering.layout')
+            ->add('view.rendered.template')
+            ->add('controller.processing');
+
+        $this->wildcards = new EventIndex();
+        $this->wildcards
+            ->add('view.rendered.template')
+            ->add('view.*.template')
+            ->add('view.rendered.*')
+            ->add('view.**')
+            ->add('controller.processing')
+            ->add('controller.process*');
+    }
+
+    public function testExpand() {
+        $this->assertEquals(Vector {'view.rendering.template', 'view.rendering.layout'}, $this->object->expand('view.rendering.*'));
+        $this->assertEquals(Vector {'view.rendering.template', 'view.rendered.template'}, $this->object->expand('view.*.template'));
+        $this->assertEquals(Vector {'controller.processing'}, $this->object->expand('controller.*'));
+        $this->assertEquals(Vector {'controller.processing'}, $this->object->expand('controller.process*'));
+        $this->assertEquals(Vector {}, $this->object->expand('model.*'));
+        $this->assertEquals(Vector {}, $this->object->expand('view.*'));
+    }
+
+    public function testExpandNamespace() {
+        $this->assertEquals(Vector {
+            'view.rendering.template',
+            'view.rendering.layout',
+            'view.rendered.template'
+        }, $this->object->expand('view.**'));
+    }
+
+    public function testMatch() {
+        $this->assertEquals(Vector {'view.rendered.template', 'view.rendered.*', 'view.*.template', 'view.**'}, $this->wildcards->match('view.rendered.template'));
+        $this->assertEquals(Vector {'view.**'}, $this->wildcards->match('view.rendering.layout'));
+        $this->assertEquals(Vector {'view.**'}, $this->wildcards->match('view.foo'));
+        $this->assertEquals(Vector {'controller.processing', 'controller.process*'}, $this->wildcards->match('controller.processing'));
+        $this->assertEquals(Vector {}, $this->wildcards->match('view'));
+        $this->assertEquals(Vector {}, $this->wildcards->match('model.saving'));
+    }
+
+    public function testRemove() {
+        $this->wildcards->remove('view.**');
+        $this->wildcards->remove('view.rendered.*');
+
+        $this->assertEquals(Vector {'view.rendered.template', 'view.*.template'}, $this->wildcards->match('view.rendered.template'));
+        $this->assertEquals(null, $this->wildcards->getChild('view')->getChild('**'));
+
+        $this->wildcards->remove('controller.processing');
+        $this->wildcards->remove('controller.process*');
+
+        $this->assertEquals(null, $this->wildcards->getChild('controller'));
+        $this->assertFalse($this->wildcards->isEmpty());
+
+        $index = new EventIndex();
+        $index->add('event.test');
+        $index->remove('event.test');
+
+        $this->assertTrue($index->isEmpty());
+    }
+
+}
@@ -30,6 +30,32 @@ class EventTest extends TestCase {
         }, $this->object->getCallStack());
     }
 
+    public function testSetCallStackCopies() {
+        $stack = Vector {'ClassName::method1'};
+        $event = (new Event('event.test'))->setCallStack($stack);
+
+        $event->getCallStack()[] = 'ClassName::method2';
+
+        $this->assertEquals(Vector {'ClassName::method1'}, $stack);
+        $this->assertEquals(Vector {'ClassName::method1', 'ClassName::method2'}, $event->getCallStack());
+    }
+
+    public function testGetCallStackDefault() {
+        $this->assertEquals(Vector {}, (new Event('event.test'))->getCallStack());
+    }
+
+    public function testGetAndSetData() {
+        $event = new Event('event.test');
+
+        $this->assertEquals(Map {}, $event->getData());
+        $this->assertEquals(null, $event->getData('key'));
+
+        $event->setData('key', 'value');
+
+        $this->assertEquals('value', $event->getData('key'));
+        $this->assertEquals(Map {'key' => 'value'}, $event->getData());
+    }
+
     public function testGetIndexAndNext() {
         $this->assertEquals(0, $this->object->getIndex());
 
@@ -43,6 +69,16 @@ class EventTest extends TestCase {
         $this->assertEquals(2, $this->object->getIndex());
     }
 
+    public function testTimeout() {
+        $this->assertFalse($this->object->isTimedOut());
+        $this->assertEquals(Vector {}, $this->object->getTimeouts());
+
+        $this->object->timeout('ClassName::method1');
+
+        $this->assertTrue($this->object->isTimedOut());
+        $this->assertEquals(Vector {'ClassName::method1'}, $this->object->getTimeouts());
+    }
+
     public function testIsStoppedAndStop() {
         $this->assertFalse($this->object->isStopped());
 
@@ -0,0 +1,127 @@
+<?hh
+namespace Titon\Event;
+
+use Titon\Test\TestCase;
+
+class ListenerCompilerTest extends TestCase {
+
+    protected function setUp() {
+        parent::setUp();
+
+        ListenerCompiler::flush();
+    }
+
+    protected function tearDown() {
+        ListenerCompiler::flush();
+
+        parent::tearDown();
+    }
+
+    public function testCompileListener() {
+        $this->assertEquals(Vector {
+            shape('event' => 'event.test1', 'method' => 'noop1', 'priority' => 0, 'once' => false, 'async' => false),
+            shape('event' => 'event.test1', 'method' => 'noop2', 'priority' => 45, 'once' => false, 'async' => false),
+            shape('event' => 'event.test2', 'method' => 'noop1', 'priority' => 0, 'once' => false, 'async' => false),
+            shape('event' => 'event.test3', 'method' => 'noop2', 'priority' => 15, 'once' => false, 'async' => false)
+        }, ListenerCompiler::compileListener(new ListenerStub()));
+    }
+
+    public function testCompileAnnotations() {
+        $this->assertEquals(Vector {
+            shape('event' => 'event.foo', 'method' => 'defaultObserver', 'priority' => 0, 'once' => false, 'async' => false),
+            shape('event' => 'event.bar', 'method' => 'priorityObserver', 'priority' => 5, 'once' => false, 'async' => false),
+            shape('event' => 'event.baz', 'method' => 'onceObserver', 'priority' => 0, 'once' => true, 'async' => false),
+            shape('event' => 'event.qux', 'method' => 'asyncObserver', 'priority' => 0, 'once' => false, 'async' => true)
+        }, ListenerCompiler::compileAnnotations(new ObserverAnnotationStub()));
+    }
+
+    public function testGetListenerWiringIsResolvedOncePerClass() {
+        $key = ListenerCompiler::getKey(ListenerCompiler::LISTENER, 'Titon\Event\ListenerStub');
+
+        $this->assertFalse(ListenerCompiler::has($key));
+
+        $wiring = ListenerCompiler::getListenerWiring(new ListenerStub());
+
+        $this->assertTrue(ListenerCompiler::has($key));
+        $this->assertSame($wiring, ListenerCompiler::getListenerWiring(new ListenerStub()));
+        $this->assertEquals([$key], array_keys(ListenerCompiler::compile()));
+    }
+
+    public function testGetListenerWiringIsResolvedPerInstance() {
+        $wiring1 = ListenerCompiler::getListenerWiring(new DynamicListenerStub('event.foo'));
+        $wiring2 = ListenerCompiler::getListenerWiring(new DynamicListenerStub('event.bar'));
+
+        $this->assertEquals('event.foo', $wiring1[0]['event']);
+        $this->assertEquals('event.bar', $wiring2[0]['event']);
+        $this->assertEquals([], ListenerCompiler::compile());
+    }
+
+    public function testGenerate() {
+        ListenerCompiler::getListenerWiring(new ListenerStub());
+
+        $source = ListenerCompiler::generate();
+
+        $this->assertStringStartsWith('<?hh', $source);
+        $this->assertContains("'listener:Titon\\\\Event\\\\ListenerStub' =>", $source);
+        $this->assertNotContains('O:', $source);
+    }
+
+    public function testWriteAndLoad() {
+        $path = TEMP_DIR . '/listeners-compiled.hh';
+
+        ListenerCompiler::getListenerWiring(new ListenerStub());
+
+        $this->assertTrue(ListenerCompiler::write($path));
+
+        ListenerCompiler::flush();
+        ListenerCompiler::load($path);
+
+        $this->assertTrue(ListenerCompiler::has(ListenerCompiler::getKey(ListenerCompiler::LISTENER, 'Titon\Event\ListenerStub')));
+
+        $emitter = new Emitter();
+        $emitter->registerListener(new ListenerStub());
+
+        $this->assertEquals(Vector {
+            'Titon\Event\ListenerStub::noop2',
+            'Titon\Event\ListenerStub::noop1'
+        }, $emitter->getCallStack('event.test1'));
+
+        unlink($path);
+    }
+
+    public function testLoadedWiringSkipsResolving() {
+        $path = TEMP_DIR . '/listeners-compiled.hh';
+
+        file_put_contents($path, '<?hh return ' . var_export([
+            ListenerCompiler::getKey(ListenerCompiler::LISTENER, 'Titon\Event\ListenerStub') => [
+                shape('event' => 'event.custom', 'method' => 'noop1', 'priority' => 5, 'once' => false, 'async' => false)
+            ]
+        ], true) . ';');
+
+        ListenerCompiler::load($path);
+
+        $emitter = new Emitter();
+        $emitter->registerListener(new ListenerStub());
+
+        $this->assertEquals(Vector {'event.custom'}, $emitter->getEventKeys());
+
+        unlink($path);
+    }
+
+}
+
+class DynamicListenerStub implements Listener {
+
+    protected string $event;
+
+    public function __construct(string $event) {
+        $this->event = $event;
+    }
+
+    public function registerEvents(): ListenerMap {
+        return Map {$this->event => 'noop'};
+    }
+
+    public function noop(Event $event): void {}
+
+}
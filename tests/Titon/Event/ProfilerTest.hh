@@ -0,0 +1,58 @@
+<?hh
+namespace Titon\Event;
+
+use Titon\Test\TestCase;
+
+/**
+ * @property \Titon\Event\Profiler $object
+ */
+class ProfilerTest extends TestCase {
+
+    protected function setUp() {
+        parent::setUp();
+
+        $this->object = new Profiler();
+        $this->object
+            ->record('event.foo', 'Foo::fast', 0.001, 100)
+            ->record('event.foo', 'Foo::slow', 0.050, 200)
+            ->record('event.foo', 'Foo::fast', 0.003, 100)
+            ->record('event.bar', 'Bar::slowest', 0.5, 0);
+    }
+
+    public function testRecordAndGetMetrics() {
+        $this->assertEquals(Map {
+            'event.foo' => Map {
+                'Foo::fast' => shape('caller' => 'Foo::fast', 'count' => 2, 'time' => 0.004, 'maxTime' => 0.003, 'memory' => 200),
+                'Foo::slow' => shape('caller' => 'Foo::slow', 'count' => 1, 'time' => 0.050, 'maxTime' => 0.050, 'memory' => 200)
+            }
+        }, $this->object->getMetrics('event.foo'));
+
+        $this->assertEquals(2, count($this->object->getMetrics()));
+        $this->assertEquals(Map {}, $this->object->getMetrics('event.baz'));
+    }
+
+    public function testGetSlowest() {
+        $slowest = $this->object->getSlowest(1);
+
+        $this->assertEquals(Vector {'event.bar', 'event.foo'}, $slowest->keys());
+        $this->assertEquals(1, count($slowest['event.foo']));
+        $this->assertEquals('Foo::slow', $slowest['event.foo'][0]['caller']);
+    }
+
+    public function testSummary() {
+        $this->assertEquals(
+            '[event.bar]' . PHP_EOL .
+            '    Bar::slowest: 500.00 ms total, 500.00 ms max, 1 calls, 0 bytes' . PHP_EOL .
+            '[event.foo]' . PHP_EOL .
+            '    Foo::slow: 50.00 ms total, 50.00 ms max, 1 calls, 200 bytes' . PHP_EOL .
+            '    Foo::fast: 4.00 ms total, 3.00 ms max, 2 calls, 200 bytes' . PHP_EOL
+        , $this->object->summary());
+    }
+
+    public function testFlush() {
+        $this->object->flush();
+
+        $this->assertEquals(Map {}, $this->object->getMetrics());
+    }
+
+}
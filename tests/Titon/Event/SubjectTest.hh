@@ -18,6 +18,25 @@ class SubjectTest extends TestCase {
         $this->assertInstanceOf('Titon\Event\Event', $this->object->emit('event.test', []));
     }
 
+    public function testEmitDeferred() {
+        $count = 0;
+
+        $this->object->on('event.test', function(Event $event) use (&$count) { $count++; });
+
+        $this->assertTrue($this->object->emitDeferred('event.test', []));
+        $this->assertTrue($this->object->emitDeferred('event.test', [], true));
+        $this->assertTrue($this->object->emitDeferred('event.test', [], true));
+        $this->assertEquals(0, $count);
+
+        $queue = DeferredQueue::registry();
+
+        $this->assertEquals(2, $queue->count());
+
+        $queue->dispatch();
+
+        $this->assertEquals(2, $count);
+    }
+
     public function testEmitMany() {
         $events = $this->object->emitMany('event.foo event.bar', []);
 
@@ -34,9 +53,9 @@ class SubjectTest extends TestCase {
         $this->object->on('event', $listener);
 
         $this->assertEquals(Vector {
+            new Observer(inst_meth($listener, 'noop2'), 45, false),
             new Observer($callback, 100, false),
             new Observer(inst_meth($listener, 'noop1'), 101, false),
-            new Observer(inst_meth($listener, 'noop2'), 45, false),
         }, $this->object->getEmitter()->getObservers('event.test1'));
 
         $this->object->off('event.test1', $callback);
@@ -1,6 +1,9 @@
 <?hh
 namespace Titon\Http\Server;
 
+use Titon\Event\DeferredQueue;
+use Titon\Event\Emitter;
+use Titon\Event\Event;
 use Titon\Http\Http;
 use Titon\Http\Stream\MemoryStream;
 use Titon\Test\TestCase;
@@ -371,6 +374,37 @@ class ResponseTest extends TestCase {
         $this->assertEquals('<html><body>body</body></html>', $this->object->send());
     }
 
+    public function testSendDispatchesDeferredEvents() {
+        $count = 0;
+        $emitter = new Emitter();
+        $emitter->register('event.test', function(Event $event) use (&$count) { $count++; });
+
+        DeferredQueue::registry()->push($emitter, 'event.test', []);
+
+        $response = new Response(new MemoryStream('body'));
+
+        ob_start();
+        $response->send();
+        ob_end_clean();
+
+        $this->assertEquals(1, $count);
+        $this->assertEquals(0, DeferredQueue::registry()->count());
+    }
+
+    public function testSendDispatchesDeferredEventsWhileDebugging() {
+        $count = 0;
+        $emitter = new Emitter();
+        $emitter->register('event.test', function(Event $event) use (&$count) { $count++; });
+
+        DeferredQueue::registry()->push($emitter, 'event.test', []);
+
+        $this->object->body(new MemoryStream('body'));
+
+        $this->assertEquals('body', $this->object->send());
+        $this->assertEquals(1, $count);
+        $this->assertEquals(0, DeferredQueue::registry()->count());
+    }
+
     public function testSetHeader() {
         $this->object->setHeader('X-Framework', 'Titon');
         $this->assertEquals('Titon', $this->object->getHeader('X-Framework'));
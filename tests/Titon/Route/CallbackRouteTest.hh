@@ -40,4 +40,12 @@ class CallbackRouteTest extends TestCase {
         $route->dispatch();
     }
 
+    /**
+     * @expectedException \Titon\Route\Exception\UncompilableRouteException
+     */
+    public function testExport() {
+        $route = new CallbackRoute('/', function(): string { return ''; });
+        $route->export();
+    }
+
 }
\ No newline at end of file
@@ -0,0 +1,73 @@
+<?hh
+namespace Titon\Route;
+
+use Titon\Cache\Storage\MemoryStorage;
+use Titon\Test\TestCase;
+
+/**
+ * @property \Titon\Route\MatchCache $object
+ */
+class MatchCacheTest extends TestCase {
+
+    protected function setUp() {
+        parent::setUp();
+
+        $this->object = new MatchCache(2);
+    }
+
+    public function testGetSet() {
+        $result = shape('route' => 'users', 'url' => '/users', 'params' => []);
+
+        $this->assertEquals(null, $this->object->get('abc', 'get:http:/users'));
+
+        $this->object->set('abc', 'get:http:/users', $result);
+
+        $this->assertEquals($result, $this->object->get('abc', 'get:http:/users'));
+        $this->assertEquals(null, $this->object->get('abc', 'post:http:/users'));
+    }
+
+    public function testCapacityEvictsLeastRecentlyUsed() {
+        $this->object->set('abc', 'a', shape('route' => 'a', 'url' => '/a', 'params' => []));
+        $this->object->set('abc', 'b', shape('route' => 'b', 'url' => '/b', 'params' => []));
+
+        // Touch a so that b is evicted
+        $this->object->get('abc', 'a');
+        $this->object->set('abc', 'c', shape('route' => 'c', 'url' => '/c', 'params' => []));
+
+        $this->assertEquals(2, $this->object->count());
+        $this->assertNotEquals(null, $this->object->get('abc', 'a'));
+        $this->assertEquals(null, $this->object->get('abc', 'b'));
+        $this->assertNotEquals(null, $this->object->get('abc', 'c'));
+    }
+
+    public function testFingerprintChangeDiscardsResults() {
+        $this->object->set('abc', 'a', shape('route' => 'a', 'url' => '/a', 'params' => []));
+
+        $this->assertEquals(1, $this->object->count());
+        $this->assertEquals(null, $this->object->get('def', 'a'));
+        $this->assertEquals(0, $this->object->count());
+    }
+
+    public function testSharedThroughStorage() {
+        $storage = new MemoryStorage();
+        $result = shape('route' => 'a', 'url' => '/a', 'params' => []);
+
+        (new MatchCache(10, $storage))->set('abc', 'a', $result);
+
+        $cache = new MatchCache(10, $storage);
+
+        $this->assertEquals($result, $cache->get('abc', 'a'));
+        $this->assertEquals(1, $cache->count());
+
+        // Results for other route tables are never shared
+        $this->assertEquals(null, (new MatchCache(10, $storage))->get('def', 'a'));
+    }
+
+    public function testFlush() {
+        $this->object->set('abc', 'a', shape('route' => 'a', 'url' => '/a', 'params' => []));
+        $this->object->flush();
+
+        $this->assertEquals(0, $this->object->count());
+    }
+
+}
@@ -0,0 +1,116 @@
+<?hh
+namespace Titon\Route\Matcher;
+
+use Titon\Route\Route;
+use Titon\Route\Router;
+use Titon\Test\TestCase;
+use Titon\Utility\State\Server;
+
+/**
+ * @property \Titon\Route\Matcher\CombinedRegexMatcher $object
+ */
+class CombinedRegexMatcherTest extends TestCase {
+
+    protected function setUp() {
+        parent::setUp();
+
+        $this->object = new CombinedRegexMatcher(2);
+    }
+
+    public function testBuild() {
+        $chunks = $this->object->build(Map {
+            'root' => new Route('/', 'Controller@action'),
+            'users' => new Route('/users', 'Controller@action'),
+            'users.read' => new Route('/users/[id]', 'Controller@action'),
+            'module' => new Route('/{module}/{controller?}', 'Controller@action')
+        });
+
+        $this->assertEquals(2, count($chunks));
+
+        $this->assertEquals('~^(?|\/()|\/users\/?()())$~i', $chunks[0]['regex']);
+        $this->assertEquals(Map {2 => 0, 3 => 1}, $chunks[0]['routes']);
+
+        $this->assertEquals('~^(?|\/users\/([0-9\.]+)\/?()|\/([a-z0-9\_\-\.]+)(?:\/([a-z0-9\_\-\.]+))?\/?())$~i', $chunks[1]['regex']);
+        $this->assertEquals(Map {3 => 2, 4 => 3}, $chunks[1]['routes']);
+    }
+
+    public function testCountGroups() {
+        $this->assertEquals(0, $this->object->countGroups('\/users\/?'));
+        $this->assertEquals(1, $this->object->countGroups('\/users\/([0-9\.]+)\/?'));
+        $this->assertEquals(1, $this->object->countGroups('\/([a-z]{2}(?:-[a-z]{2})?)\/?'));
+        $this->assertEquals(2, $this->object->countGroups('\/(a)(?:\/([^\/(]+))?\/?'));
+        $this->assertEquals(1, $this->object->countGroups('\/\(escaped\)\/(?P<id>[0-9]+)'));
+    }
+
+    public function testMatch() {
+        $routes = Map {
+            'action.ext' => new Route('/{module}/{controller}/{action}.{ext}', 'Module\Controller@action'),
+            'action' => new Route('/{module}/{controller}/{action}', 'Module\Controller@action'),
+            'controller' => new Route('/{module}/{controller}', 'Module\Controller@action'),
+            'module' => new Route('/{module}', 'Module\Controller@action'),
+            'root' => new Route('/', 'Module\Controller@action')
+        };
+
+        $this->assertEquals('/', $this->object->match('/', $routes)?->getPath());
+        $this->assertEquals('/{module}', $this->object->match('/users', $routes)?->getPath());
+        $this->assertEquals('/{module}/{controller}', $this->object->match('/users/profile', $routes)?->getPath());
+        $this->assertEquals('/{module}/{controller}/{action}', $this->object->match('/users/profile/view', $routes)?->getPath());
+        $this->assertEquals('/{module}/{controller}/{action}.{ext}', $this->object->match('/users/profile/view.json', $routes)?->getPath());
+        $this->assertEquals(null, $this->object->match('/path~tilde', $routes));
+    }
+
+    public function testMatchParams() {
+        $routes = Map {
+            'users' => new Route('/users', 'Controller@action'),
+            'blog' => new Route('/blog/[year]/[month]/[day?]', 'Controller@action'),
+            'action.ext' => new Route('/{module}/{controller}/{action}.{ext}', 'Controller@action')
+        };
+
+        $route = $this->object->match('/users/profile/activity.json', $routes);
+
+        $this->assertEquals('/users/profile/activity.json', $route?->url());
+        $this->assertEquals(Map {
+            'module' => 'users',
+            'controller' => 'profile',
+            'action' => 'activity',
+            'ext' => 'json'
+        }, $route?->getParams());
+
+        $route = $this->object->match('/blog/2014/02', $routes);
+
+        $this->assertEquals('/blog/2014/02', $route?->url());
+        $this->assertEquals(Map {
+            'year' => '2014',
+            'month' => '02',
+            'day' => ''
+        }, $route?->getParams());
+    }
+
+    public function testMatchRespectsMethods() {
+        $routes = Map {
+            'users.create' => (new Route('/users', 'Controller@action'))->setMethods(Vector {'post'}),
+            'users.list' => (new Route('/users', 'Controller@action'))->setMethods(Vector {'get'}),
+            'users.read' => (new Route('/users/[id]', 'Controller@action'))->setMethods(Vector {'get'})
+        };
+
+        $this->assertEquals(Vector {'get'}, $this->object->match('/users', $routes)?->getMethods());
+
+        $_SERVER['REQUEST_METHOD'] = 'POST';
+        Server::initialize($_SERVER);
+
+        $this->assertEquals(Vector {'post'}, $this->object->match('/users', $routes)?->getMethods());
+        $this->assertEquals(null, $this->object->match('/users/1', $routes));
+    }
+
+    public function testWithRouter() {
+        $router = new Router();
+        $router->setMatcher(new CombinedRegexMatcher());
+        $router->map('module', new Route('/{module}', 'Controller@action'));
+        $router->map('root', new Route('/', 'Controller@action'));
+
+        $this->assertEquals('/{module}', $router->match('/users')->getPath());
+        $this->assertEquals('users', $router->match('/users')->getParam('module'));
+        $this->assertEquals('/', $router->match('/')->getPath());
+    }
+
+}
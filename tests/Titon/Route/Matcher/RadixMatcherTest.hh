@@ -0,0 +1,144 @@
+<?hh
+namespace Titon\Route\Matcher;
+
+use Titon\Route\Route;
+use Titon\Route\Router;
+use Titon\Test\TestCase;
+use Titon\Utility\State\Server;
+
+/**
+ * @property \Titon\Route\Matcher\RadixMatcher $object
+ */
+class RadixMatcherTest extends TestCase {
+
+    protected function setUp() {
+        parent::setUp();
+
+        $this->object = new RadixMatcher();
+    }
+
+    public function testBuild() {
+        $tree = $this->object->build(Map {
+            'root' => new Route('/', 'Controller@action'),
+            'users' => new Route('/users', 'Controller@action'),
+            'users.read' => new Route('/users/[id]', 'Controller@action'),
+            'users.edit' => new Route('/users/[id]/edit', 'Controller@action'),
+            'module' => new Route('/{module}', 'Controller@action')
+        });
+
+        $this->assertEquals(Vector {0}, $tree->getStatic());
+        $this->assertEquals(Vector {4}, $tree->getDynamic());
+        $this->assertEquals(Vector {'users'}, $tree->getChildren()->keys());
+
+        $users = $tree->getChild('users');
+
+        $this->assertEquals(Vector {1}, $users?->getStatic());
+        $this->assertEquals(Vector {2, 3}, $users?->getDynamic());
+    }
+
+    public function testBuildOptionalTokenWithinSegment() {
+        $tree = $this->object->build(Map {
+            'blog' => new Route('/blog/{year?}.{ext}', 'Controller@action')
+        });
+
+        // Must be placed on the parent, as the token absorbs the slash
+        $this->assertEquals(Vector {0}, $tree->getDynamic());
+    }
+
+    public function testIsStaticSegment() {
+        $this->assertTrue($this->object->isStaticSegment('users'));
+        $this->assertTrue($this->object->isStaticSegment('group-1'));
+        $this->assertTrue($this->object->isStaticSegment('index.html'));
+        $this->assertFalse($this->object->isStaticSegment('{module}'));
+        $this->assertFalse($this->object->isStaticSegment('[id]'));
+        $this->assertFalse($this->object->isStaticSegment('(wild)'));
+        $this->assertFalse($this->object->isStaticSegment('<locale>'));
+        $this->assertFalse($this->object->isStaticSegment('{action}.{ext}'));
+        $this->assertFalse($this->object->isStaticSegment('foo+'));
+    }
+
+    public function testMatch() {
+        $routes = Map {
+            'action.ext' => new Route('/{module}/{controller}/{action}.{ext}', 'Module\Controller@action'),
+            'action' => new Route('/{module}/{controller}/{action}', 'Module\Controller@action'),
+            'controller' => new Route('/{module}/{controller}', 'Module\Controller@action'),
+            'module' => new Route('/{module}', 'Module\Controller@action'),
+            'root' => new Route('/', 'Module\Controller@action')
+        };
+
+        $this->assertEquals('/', $this->object->match('/', $routes)?->getPath());
+        $this->assertEquals('/{module}', $this->object->match('/users', $routes)?->getPath());
+        $this->assertEquals('/{module}/{controller}', $this->object->match('/users/profile', $routes)?->getPath());
+        $this->assertEquals('/{module}/{controller}/{action}', $this->object->match('/users/profile/view', $routes)?->getPath());
+        $this->assertEquals('/{module}/{controller}/{action}.{ext}', $this->object->match('/users/profile/view.json', $routes)?->getPath());
+        $this->assertEquals(null, $this->object->match('/path~tilde', $routes));
+    }
+
+    public function testMatchFirstMappedWins() {
+        $routes = Map {
+            'module' => new Route('/{module}', 'Controller@action'),
+            'users' => new Route('/users', 'Controller@action'),
+            'users.read' => new Route('/users/[id]', 'Controller@action'),
+            'users.wild' => new Route('/users/(wild)', 'Controller@action')
+        };
+
+        $this->assertEquals('/{module}', $this->object->match('/users', $routes)?->getPath());
+        $this->assertEquals('/users/[id]', $this->object->match('/users/123', $routes)?->getPath());
+        $this->assertEquals('/users/(wild)', $this->object->match('/users/abc', $routes)?->getPath());
+    }
+
+    public function testMatchStaticSegments() {
+        $routes = Map {
+            'users' => new Route('/users', 'Controller@action'),
+            'users.list' => new Route('/users/list', 'Controller@action'),
+            'users.read' => new Route('/users/[id?]', 'Controller@action')
+        };
+
+        $this->assertEquals('/users', $this->object->match('/users', $routes)?->getPath());
+        $this->assertEquals('/users', $this->object->match('/USERS/', $routes)?->getPath());
+        $this->assertEquals('/users/list', $this->object->match('/users/list', $routes)?->getPath());
+        $this->assertEquals('/users/[id?]', $this->object->match('/users/5', $routes)?->getPath());
+        $this->assertEquals(null, $this->object->match('/posts', $routes));
+        $this->assertEquals(null, $this->object->match('/users/list/foo', $routes));
+    }
+
+    public function testMatchRespectsMethods() {
+        $routes = Map {
+            'users.create' => (new Route('/users', 'Controller@action'))->setMethods(Vector {'post'}),
+            'users.list' => (new Route('/users', 'Controller@action'))->setMethods(Vector {'get'})
+        };
+
+        $this->assertEquals(Vector {'get'}, $this->object->match('/users', $routes)?->getMethods());
+
+        $_SERVER['REQUEST_METHOD'] = 'POST';
+        Server::initialize($_SERVER);
+
+        $this->assertEquals(Vector {'post'}, $this->object->match('/users', $routes)?->getMethods());
+    }
+
+    public function testTreeIsRebuiltWhenRoutesChange() {
+        $routes = Map {
+            'users' => new Route('/users', 'Controller@action')
+        };
+
+        $tree = $this->object->getTree($routes);
+
+        $this->assertSame($tree, $this->object->getTree($routes));
+
+        $routes['posts'] = new Route('/posts', 'Controller@action');
+
+        $this->assertNotSame($tree, $this->object->getTree($routes));
+        $this->assertEquals('/posts', $this->object->match('/posts', $routes)?->getPath());
+    }
+
+    public function testWithRouter() {
+        $router = new Router();
+        $router->setMatcher($this->object);
+        $router->map('module', new Route('/{module}', 'Controller@action'));
+        $router->map('root', new Route('/', 'Controller@action'));
+
+        $this->assertEquals('/{module}', $router->match('/users')->getPath());
+        $this->assertEquals('/', $router->match('/')->getPath());
+    }
+
+}
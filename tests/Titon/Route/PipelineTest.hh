@@ -0,0 +1,82 @@
+<?hh
+namespace Titon\Route;
+
+use Titon\Test\TestCase;
+
+/**
+ * @property \Titon\Route\Pipeline $object
+ */
+class PipelineTest extends TestCase {
+
+    protected function setUp() {
+        parent::setUp();
+
+        $this->object = new Pipeline();
+    }
+
+    public function testAddGroupsConsecutiveAsyncFilters() {
+        $sync = function() {};
+        $async = async function() {};
+
+        $this->object
+            ->addAsync($async)
+            ->addAsync($async)
+            ->add($sync)
+            ->addAsync($async);
+
+        $stages = $this->object->getStages();
+
+        $this->assertEquals(4, $this->object->count());
+        $this->assertEquals(3, count($stages));
+        $this->assertEquals(2, count($stages[0]['async']));
+        $this->assertEquals($sync, $stages[1]['callback']);
+        $this->assertEquals(1, count($stages[2]['async']));
+    }
+
+    public function testRun() {
+        $router = new Router();
+        $route = new Route('/', 'Controller@action');
+        $order = [];
+
+        $this->object
+            ->add(function() use (&$order) { $order[] = 1; })
+            ->add(function() use (&$order) { $order[] = 2; });
+
+        $this->assertFalse($this->object->isAsync());
+        $this->assertEquals(null, $this->object->run($router, $route));
+        $this->assertEquals([1, 2], $order);
+    }
+
+    public function testRunShortCircuits() {
+        $router = new Router();
+        $route = new Route('/', 'Controller@action');
+        $order = [];
+
+        $this->object
+            ->add(function() use (&$order) { $order[] = 1; return 'response'; })
+            ->add(function() use (&$order) { $order[] = 2; });
+
+        $this->assertEquals('response', $this->object->run($router, $route));
+        $this->assertEquals([1], $order);
+    }
+
+    public function testRunAsync() {
+        $router = new Router();
+        $route = new Route('/', 'Controller@action');
+        $order = [];
+
+        $this->object
+            ->add(function() use (&$order) { $order[] = 'sync'; })
+            ->addAsync(async function() use (&$order) { $order[] = 'a'; })
+            ->addAsync(async function() use (&$order) { $order[] = 'b'; return 'first'; })
+            ->addAsync(async function() use (&$order) { $order[] = 'c'; return 'second'; })
+            ->add(function() use (&$order) { $order[] = 'never'; });
+
+        $this->assertTrue($this->object->isAsync());
+        $this->assertEquals('first', $this->object->run($router, $route));
+
+        // The whole async stage is awaited together
+        $this->assertEquals(['sync', 'a', 'b', 'c'], $order);
+    }
+
+}
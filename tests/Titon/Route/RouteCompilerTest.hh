@@ -0,0 +1,69 @@
+<?hh
+namespace Titon\Route;
+
+use Titon\Test\TestCase;
+
+/**
+ * @property \Titon\Route\Router $router
+ * @property \Titon\Route\RouteCompiler $object
+ */
+class RouteCompilerTest extends TestCase {
+
+    protected function setUp() {
+        parent::setUp();
+
+        $this->router = new Router();
+        $this->router->map('root', new Route('/', 'Controller@index'));
+        $this->router->get('users', new Route('/users', 'Users@index'));
+        $this->router->map('users.read', (new Route('/users/[id]', 'Users@read'))->setFilters(Vector {'auth'}));
+
+        $this->object = new RouteCompiler($this->router);
+    }
+
+    public function testCompile() {
+        $routes = $this->object->compile();
+
+        $this->assertEquals(['root', 'users', 'users.read'], array_keys($routes));
+        $this->assertEquals('\/users\/(?P<id>[0-9\.]+)\/?', $routes['users.read']['compiled']);
+        $this->assertEquals(['get'], $routes['users']['methods']);
+        $this->assertEquals(['auth'], $routes['users.read']['filters']);
+    }
+
+    /**
+     * @expectedException \Titon\Route\Exception\UncompilableRouteException
+     */
+    public function testCompileCallbackRoute() {
+        $this->router->map('callback', new CallbackRoute('/callback', function() {}));
+
+        $this->object->compile();
+    }
+
+    public function testGenerate() {
+        $source = $this->object->generate();
+
+        $this->assertStringStartsWith('<?hh', $source);
+        $this->assertContains("'users.read' =>", $source);
+        $this->assertNotContains('O:', $source); // No serialized objects
+    }
+
+    public function testWriteAndLoad() {
+        $path = TEMP_DIR . '/routes-compiled.hh';
+
+        $this->assertTrue($this->object->write($path));
+
+        $router = new Router();
+        $router->loadCompiled($path);
+
+        $this->assertTrue($router->isCached());
+        $this->assertEquals(Vector {'root', 'users', 'users.read'}, $router->getRoutes()->keys());
+
+        $route = $router->match('/users/5');
+
+        $this->assertEquals('/users/[id]', $route->getPath());
+        $this->assertEquals(5, $route->getParam('id'));
+        $this->assertEquals('/users', $router->match('/users')->getPath());
+
+        unlink($path);
+    }
+
+}
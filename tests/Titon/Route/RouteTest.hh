@@ -56,10 +56,10 @@ class RouteTest extends TestCase {
         $module = new Route('/{module}', 'Controller@action');
         $root = (new Route('/', 'Controller@action'))->setStatic(true);
 
-        $this->assertEquals('\/([a-z0-9\_\-\.]+)\/([a-z0-9\_\-\.]+)\/([a-z0-9\_\-\.]+)\.([a-z0-9\_\-\.]+)\/?', $moduleControllerActionExt->compile());
-        $this->assertEquals('\/([a-z0-9\_\-\.]+)\/([a-z0-9\_\-\.]+)\/([a-z0-9\_\-\.]+)\/?', $moduleControllerAction->compile());
-        $this->assertEquals('\/([a-z0-9\_\-\.]+)\/([a-z0-9\_\-\.]+)\/?', $moduleController->compile());
-        $this->assertEquals('\/([a-z0-9\_\-\.]+)\/?', $module->compile());
+        $this->assertEquals('\/(?P<module>[a-z0-9\_\-\.]+)\/(?P<controller>[a-z0-9\_\-\.]+)\/(?P<action>[a-z0-9\_\-\.]+)\.(?P<ext>[a-z0-9\_\-\.]+)\/?', $moduleControllerActionExt->compile());
+        $this->assertEquals('\/(?P<module>[a-z0-9\_\-\.]+)\/(?P<controller>[a-z0-9\_\-\.]+)\/(?P<action>[a-z0-9\_\-\.]+)\/?', $moduleControllerAction->compile());
+        $this->assertEquals('\/(?P<module>[a-z0-9\_\-\.]+)\/(?P<controller>[a-z0-9\_\-\.]+)\/?', $moduleController->compile());
+        $this->assertEquals('\/(?P<module>[a-z0-9\_\-\.]+)\/?', $module->compile());
         $this->assertEquals('\/', $root->compile());
 
         $multi = new Route('{alpha}/[numeric]/(wildcard)/', 'Controller@action');
@@ -74,9 +74,27 @@ class RouteTest extends TestCase {
             'locale' => '([a-z]{2}(?:-[a-z]{2})?)'
         });
 
-        $this->assertEquals('\/([a-z0-9\_\-\.]+)\/([0-9\.]+)\/([^\/]+)\/?', $multi->compile());
-        $this->assertEquals('\/([a-z0-9\_\-\.]+)\/([a-z]{2}(?:-[a-z]{2})?)\/?', $patterns->compile());
-        $this->assertEquals('\/([a-z]{2}(?:-[a-z]{2})?)\/([a-z0-9\_\-\.]+)\/([^\/]+)\/([0-9\.]+)\/([a-z0-9\_\-\.]+)\/?', $allTypes->compile());
+        $this->assertEquals('\/(?P<alpha>[a-z0-9\_\-\.]+)\/(?P<numeric>[0-9\.]+)\/(?P<wildcard>[^\/]+)\/?', $multi->compile());
+        $this->assertEquals('\/(?P<alnum>[a-z0-9\_\-\.]+)\/(?P<locale>[a-z]{2}(?:-[a-z]{2})?)\/?', $patterns->compile());
+        $this->assertEquals('\/(?P<locale>[a-z]{2}(?:-[a-z]{2})?)\/(?P<alpha>[a-z0-9\_\-\.]+)\/(?P<wildcard>[^\/]+)\/(?P<numeric>[0-9\.]+)\/(?P<alnum>[a-z0-9\_\-\.]+)\/?', $allTypes->compile());
+    }
+
+    public function testCompileInvalidGroupNames() {
+        $route = (new Route('/{1st}/<my-pattern>', 'Controller@action'))->setPatterns(Map {
+            'my-pattern' => '(\d+)'
+        });
+
+        $this->assertEquals('\/([a-z0-9\_\-\.]+)\/(\d+)\/?', $route->compile());
+        $this->assertTrue($route->isMatch('/abc/42'));
+        $this->assertEquals(Map {'1st' => 'abc', 'my-pattern' => 42}, $route->getParams());
+    }
+
+    public function testCompileDuplicateTokens() {
+        $route = new Route('/{id}/compare/{id}', 'Controller@action');
+
+        $this->assertEquals('\/(?P<id>[a-z0-9\_\-\.]+)\/compare\/([a-z0-9\_\-\.]+)\/?', $route->compile());
+        $this->assertTrue($route->isMatch('/foo/compare/bar'));
+        $this->assertEquals(Map {'id' => 'foo'}, $route->getParams());
     }
 
     /**
@@ -90,13 +108,13 @@ class RouteTest extends TestCase {
     public function testCompileOptionalToken() {
         $route = new Route('/users/[id]', 'Controller@action');
 
-        $this->assertEquals('\/users\/([0-9\.]+)\/?', $route->compile());
+        $this->assertEquals('\/users\/(?P<id>[0-9\.]+)\/?', $route->compile());
         $this->assertTrue($route->isMatch('/users/1'));
         $this->assertFalse($route->isMatch('/users'));
 
         $route = new Route('/users/[id?]', 'Controller@action');
 
-        $this->assertEquals('\/users(?:\/([0-9\.]+))?\/?', $route->compile());
+        $this->assertEquals('\/users(?:\/(?P<id>[0-9\.]+))?\/?', $route->compile());
         $this->assertTrue($route->isMatch('/users/1'));
         $this->assertTrue($route->isMatch('/users/'));
         $this->assertTrue($route->isMatch('/users'));
@@ -146,6 +164,60 @@ class RouteTest extends TestCase {
         $this->assertEquals(Vector {'baz'}, $route->getFilters());
     }
 
+    public function testExportImport() {
+        $route = (new Route('/users/[id]/{action?}', 'Controller@action'))
+            ->setMethods(Vector {'get', 'post'})
+            ->setFilters(Vector {'auth'})
+            ->setPatterns(Map {'action' => '[a-z]+'})
+            ->setSecure(true);
+
+        $data = $route->export();
+
+        $this->assertEquals('Titon\Route\Route', $data['class']);
+        $this->assertEquals('\/users\/(?P<id>[0-9\.]+)(?:\/(?P<action>[a-z0-9\_\-\.]+))?\/?', $data['compiled']);
+        $this->assertEquals([
+            shape('token' => 'id', 'optional' => false, 'type' => 'numeric', 'group' => 1),
+            shape('token' => 'action', 'optional' => true, 'type' => 'string', 'group' => 2)
+        ], $data['tokens']);
+
+        $import = Route::import($data);
+
+        $this->assertTrue($import->isCompiled());
+        $this->assertEquals($route->getPath(), $import->getPath());
+        $this->assertEquals($route->getAction(), $import->getAction());
+        $this->assertEquals($route->getTokens(), $import->getTokens());
+        $this->assertEquals(Vector {'get', 'post'}, $import->getMethods());
+        $this->assertEquals(Vector {'auth'}, $import->getFilters());
+        $this->assertEquals(Map {'action' => '[a-z]+'}, $import->getPatterns());
+        $this->assertTrue($import->getSecure());
+    }
+
+    public function testExportImportCustomConstructor() {
+        $route = new ImportableRoute('/users/[id]', 'Controller@action', 'admin');
+        $import = Route::import($route->export());
+
+        $this->assertInstanceOf('Titon\Route\ImportableRoute', $import);
+        $this->assertEquals('/users/[id]', $import->getPath());
+        $this->assertEquals('admin', $import->area);
+    }
+
+    /**
+     * @expectedException \Titon\Route\Exception\UncompilableRouteException
+     */
+    public function testExportIncompatibleConstructor() {
+        $route = new NonImportableRoute(123, '/users', 'Controller@action');
+        $route->export();
+    }
+
+    /**
+     * @expectedException \Titon\Route\Exception\UncompilableRouteException
+     */
+    public function testExportWithConditions() {
+        $route = new Route('/', 'Controller@action');
+        $route->addCondition(function() {});
+        $route->export();
+    }
+
     public function testGetAction() {
         $route = new Route('/', 'Controller@action');
 
@@ -199,6 +271,24 @@ class RouteTest extends TestCase {
         $this->assertTrue($secureRoute->isSecure());
     }
 
+    public function testIsSecureRequest() {
+        $this->assertFalse(Route::isSecureRequest());
+
+        $_SERVER['SERVER_PORT'] = 443;
+        Server::initialize($_SERVER);
+
+        $this->assertTrue(Route::isSecureRequest());
+    }
+
+    public function testRestore() {
+        $route = new Route('/posts/[id]/{slug?}', 'Posts@read');
+        $route->restore('/posts/5', Map {'id' => 5, 'slug' => null});
+
+        $this->assertEquals('/posts/5', $route->url());
+        $this->assertSame(5, $route->getParams()['id']);
+        $this->assertSame(null, $route->getParams()['slug']);
+    }
+
     public function testIsStatic() {
         $route = (new Route('/', 'Controller@action'))->setStatic(false);
         $staticRoute = (new Route('/', 'Controller@action'))->setStatic(true);
@@ -386,7 +476,7 @@ class RouteTest extends TestCase {
         $this->assertEquals('/blog/2014/02', $route->url());
 
         $this->assertEquals(Map {
-            'year' => '2014',
+            'year' => 2014,
             'month' => '02',
             'day' => ''
         }, $route->getParams());
@@ -396,12 +486,73 @@ class RouteTest extends TestCase {
         $this->assertEquals('/blog/2014/02/05', $route->url());
 
         $this->assertEquals(Map {
-            'year' => '2014',
+            'year' => 2014,
             'month' => '02',
             'day' => '05'
         }, $route->getParams());
     }
 
+    public function testParamsNestedGroups() {
+        $route = (new Route('/<version>/{page}', 'Controller@action'))->setPatterns(Map {
+            'version' => 'v(1|2)'
+        });
+
+        $route->compile();
+
+        $this->assertEquals(3, $route->getTokens()[1]['group']);
+        $this->assertTrue($route->isMatch('/v2/home'));
+        $this->assertEquals(Map {'version' => 'v2', 'page' => 'home'}, $route->getParams());
+
+        // Positional matches are mapped by group position
+        $route->match(['/v1/about', 'v1', '1', 'about']);
+
+        $this->assertEquals(Map {'version' => 'v1', 'page' => 'about'}, $route->getParams());
+    }
+
+    public function testParamsTyped() {
+        $route = (new Route('/users/<id>/{slug}/<code>', 'Controller@action'))->setPatterns(Map {
+            'id' => '[0-9]+',
+            'code' => '[a-z]{3}'
+        });
+
+        $this->assertEquals(Vector {
+            shape('token' => 'id', 'optional' => false, 'type' => Route::TYPE_NUMERIC, 'group' => 1),
+            shape('token' => 'slug', 'optional' => false, 'type' => Route::TYPE_STRING, 'group' => 2),
+            shape('token' => 'code', 'optional' => false, 'type' => Route::TYPE_STRING, 'group' => 3)
+        }, $route->getTokens());
+
+        $route->isMatch('/users/15/titon/abc');
+
+        $this->assertSame(15, $route->getParam('id'));
+        $this->assertSame('titon', $route->getParam('slug'));
+        $this->assertSame('abc', $route->getParam('code'));
+
+        // Positional matches are mapped by token order
+        $route->match(['/users/20/hack/xyz', '20', 'hack', 'xyz']);
+
+        $this->assertSame(20, $route->getParam('id'));
+        $this->assertSame('hack', $route->getParam('slug'));
+        $this->assertSame('xyz', $route->getParam('code'));
+
+        $route = new Route('/price/[amount]', 'Controller@action');
+        $route->isMatch('/price/12.5');
+
+        $this->assertSame(12.5, $route->getParam('amount'));
+
+        // Values that would lose data when cast remain strings
+        $route->isMatch('/price/12.50');
+
+        $this->assertSame('12.50', $route->getParam('amount'));
+
+        $route->isMatch('/price/007');
+
+        $this->assertSame('007', $route->getParam('amount'));
+
+        $route->isMatch('/price/1.');
+
+        $this->assertSame('1.', $route->getParam('amount'));
+    }
+
     public function testPatterns() {
         $route = new Route('/', 'Controller@action');
 
@@ -419,47 +570,47 @@ class RouteTest extends TestCase {
 
     public function testTokens() {
         $route = new Route('/{string}', 'Controller@action');
-        $this->assertEquals('\/([a-z0-9\_\-\.]+)\/?', $route->compile());
+        $this->assertEquals('\/(?P<string>[a-z0-9\_\-\.]+)\/?', $route->compile());
 
         $route = new Route('/{string?}', 'Controller@action');
-        $this->assertEquals('(?:\/([a-z0-9\_\-\.]+))?\/?', $route->compile());
+        $this->assertEquals('(?:\/(?P<string>[a-z0-9\_\-\.]+))?\/?', $route->compile());
 
         $route = new Route('/[int]', 'Controller@action');
-        $this->assertEquals('\/([0-9\.]+)\/?', $route->compile());
+        $this->assertEquals('\/(?P<int>[0-9\.]+)\/?', $route->compile());
 
         $route = new Route('/[int?]', 'Controller@action');
-        $this->assertEquals('(?:\/([0-9\.]+))?\/?', $route->compile());
+        $this->assertEquals('(?:\/(?P<int>[0-9\.]+))?\/?', $route->compile());
 
         $route = new Route('/(wildcard)', 'Controller@action');
-        $this->assertEquals('\/([^\/]+)\/?', $route->compile());
+        $this->assertEquals('\/(?P<wildcard>[^\/]+)\/?', $route->compile());
 
         $route = new Route('/(wildcard?)', 'Controller@action');
-        $this->assertEquals('(?:\/([^\/]+))?\/?', $route->compile());
+        $this->assertEquals('(?:\/(?P<wildcard>[^\/]+))?\/?', $route->compile());
 
         $route = (new Route('/<regex>', 'Controller@action'))->addPattern('regex', '[foo|bar]');
-        $this->assertEquals('\/([foo|bar])\/?', $route->compile());
+        $this->assertEquals('\/(?P<regex>[foo|bar])\/?', $route->compile());
 
         $route = (new Route('/<regex?>', 'Controller@action'))->addPattern('regex', '[foo|bar]');
-        $this->assertEquals('(?:\/([foo|bar]))?\/?', $route->compile());
+        $this->assertEquals('(?:\/(?P<regex>[foo|bar]))?\/?', $route->compile());
 
         $route = new Route('/<regex:[foo|bar]>', 'Controller@action');
-        $this->assertEquals('\/([foo|bar])\/?', $route->compile());
+        $this->assertEquals('\/(?P<regex>[foo|bar])\/?', $route->compile());
 
         $route = new Route('/<regex:[foo|bar]?>', 'Controller@action');
-        $this->assertEquals('(?:\/([foo|bar]))?\/?', $route->compile());
+        $this->assertEquals('(?:\/(?P<regex>[foo|bar]))?\/?', $route->compile());
 
         $route = new Route('/<regex:([a-z0-9\w\s\d\-]+)?>', 'Controller@action');
-        $this->assertEquals('(?:\/([a-z0-9\w\s\d\-]+))?\/?', $route->compile());
+        $this->assertEquals('(?:\/(?P<regex>[a-z0-9\w\s\d\-]+))?\/?', $route->compile());
         $this->assertEquals(Map {'regex' => '([a-z0-9\w\s\d\-]+)'}, $route->getPatterns());
 
         $route = new Route('/{string}/[int]', 'Controller@action');
-        $this->assertEquals('\/([a-z0-9\_\-\.]+)\/([0-9\.]+)\/?', $route->compile());
+        $this->assertEquals('\/(?P<string>[a-z0-9\_\-\.]+)\/(?P<int>[0-9\.]+)\/?', $route->compile());
 
         $route = new Route('/(wild)/{string}/[int?]', 'Controller@action');
-        $this->assertEquals('\/([^\/]+)\/([a-z0-9\_\-\.]+)(?:\/([0-9\.]+))?\/?', $route->compile());
+        $this->assertEquals('\/(?P<wild>[^\/]+)\/(?P<string>[a-z0-9\_\-\.]+)(?:\/(?P<int>[0-9\.]+))?\/?', $route->compile());
 
         $route = new Route('/(wild)/{string}/<regex:([a-z]\-[A-Z])>/[int?]', 'Controller@action');
-        $this->assertEquals('\/([^\/]+)\/([a-z0-9\_\-\.]+)\/([a-z]\-[A-Z])(?:\/([0-9\.]+))?\/?', $route->compile());
+        $this->assertEquals('\/(?P<wild>[^\/]+)\/(?P<string>[a-z0-9\_\-\.]+)\/(?P<regex>[a-z]\-[A-Z])(?:\/(?P<int>[0-9\.]+))?\/?', $route->compile());
     }
 
     public function testSerialize() {
@@ -472,7 +623,7 @@ class RouteTest extends TestCase {
 
         $serialized = serialize($route);
 
-        $this->assertEquals('C:17:"Titon\Route\Route":685:{K:6:"HH\Map":9:{s:6:"action";a:2:{s:5:"class";s:10:"Controller";s:6:"action";s:6:"action";}s:8:"compiled";s:79:"\/([a-z0-9\_\-\.]+)\/([a-z0-9\_\-\.]+)\/([a-z0-9\_\-\.]+)\.([a-z0-9\_\-\.]+)\/?";s:7:"filters";V:9:"HH\Vector":1:{s:3:"foo";}s:7:"methods";V:9:"HH\Vector":1:{s:4:"post";}s:8:"patterns";K:6:"HH\Map":1:{s:6:"locale";s:24:"([a-z]{2}(?:-[a-z]{2})?)";}s:4:"path";s:37:"/{module}/{controller}/{action}.{ext}";s:6:"secure";b:1;s:6:"static";b:0;s:6:"tokens";V:9:"HH\Vector":4:{a:2:{s:5:"token";s:6:"module";s:8:"optional";b:0;}a:2:{s:5:"token";s:10:"controller";s:8:"optional";b:0;}a:2:{s:5:"token";s:6:"action";s:8:"optional";b:0;}a:2:{s:5:"token";s:3:"ext";s:8:"optional";b:0;}}}}', $serialized);
+        $this->assertEquals('C:17:"Titon\Route\Route":887:{K:6:"HH\Map":9:{s:6:"action";a:2:{s:5:"class";s:10:"Controller";s:6:"action";s:6:"action";}s:8:"compiled";s:120:"\/(?P<module>[a-z0-9\_\-\.]+)\/(?P<controller>[a-z0-9\_\-\.]+)\/(?P<action>[a-z0-9\_\-\.]+)\.(?P<ext>[a-z0-9\_\-\.]+)\/?";s:7:"filters";V:9:"HH\Vector":1:{s:3:"foo";}s:7:"methods";V:9:"HH\Vector":1:{s:4:"post";}s:8:"patterns";K:6:"HH\Map":1:{s:6:"locale";s:24:"([a-z]{2}(?:-[a-z]{2})?)";}s:4:"path";s:37:"/{module}/{controller}/{action}.{ext}";s:6:"secure";b:1;s:6:"static";b:0;s:6:"tokens";V:9:"HH\Vector":4:{a:4:{s:5:"token";s:6:"module";s:8:"optional";b:0;s:4:"type";s:6:"string";s:5:"group";i:1;}a:4:{s:5:"token";s:10:"controller";s:8:"optional";b:0;s:4:"type";s:6:"string";s:5:"group";i:2;}a:4:{s:5:"token";s:6:"action";s:8:"optional";b:0;s:4:"type";s:6:"string";s:5:"group";i:3;}a:4:{s:5:"token";s:3:"ext";s:8:"optional";b:0;s:4:"type";s:6:"string";s:5:"group";i:4;}}}}', $serialized);
         $this->assertEquals($route, unserialize($serialized));
     }
 
@@ -490,4 +641,25 @@ class TestDispatch {
     public function typeHints(string $a, int $b, string $c): string {
         return $a . $b . $c;
     }
-}
\ No newline at end of file
+}
+
+class ImportableRoute extends Route {
+    public string $area;
+
+    public function __construct(string $path, string $action, string $area) {
+        parent::__construct($path, $action);
+
+        $this->area = $area;
+    }
+
+    public static function import(CompiledRoute $data): Route {
+        return (new ImportableRoute($data['path'], Router::buildAction($data['action']), 'admin'))
+            ->setMethods(new Vector($data['methods']));
+    }
+}
+
+class NonImportableRoute extends Route {
+    public function __construct(int $priority, string $path, string $action) {
+        parent::__construct($path, $action);
+    }
+}
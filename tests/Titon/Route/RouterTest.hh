@@ -59,6 +59,84 @@ class RouterTest extends TestCase {
         $this->assertEquals('/', $router2->getRoute('root')->getPath());
     }
 
+    public function testCachingPartitions() {
+        $storage = new MemoryStorage();
+
+        $router1 = new Router();
+        $router1->setStorage($storage);
+        $router1->map('users.read', new Route('/users/[id]', 'Users@read'));
+        $router1->map('posts.read', new Route('/posts/[id]', 'Posts@read'));
+        $router1->map('blog', new Route('/blog/{year?}.{ext}', 'Blog@index'));
+        $router1->map('module', new Route('/{module}', 'Module\Controller@action'));
+        $router1->match('/users/1');
+
+        $this->assertEquals(Map {
+            'fingerprint' => $router1->getFingerprint(),
+            'partitions' => Map {
+                'users.read' => 'users',
+                'posts.read' => 'posts',
+                'blog' => '*',
+                'module' => '*'
+            }
+        }, unserialize($storage->get('routes')));
+
+        // Only the matching partition is loaded
+        $router2 = new Router();
+        $router2->setStorage($storage);
+
+        $this->assertEquals('/users/[id]', $router2->match('/USERS/1')->getPath());
+        $this->assertTrue($router2->isCached());
+        $this->assertEquals(Vector {'users.read', 'blog', 'module'}, $router2->getMethodRoutes('GET')->keys());
+
+        // Other partitions are loaded on demand
+        $this->assertEquals('/posts/[id]', $router2->match('/posts/1')->getPath());
+        $this->assertEquals(Vector {'users.read', 'posts.read', 'blog', 'module'}, $router2->getMethodRoutes('GET')->keys());
+
+        $router3 = new Router();
+        $router3->setStorage($storage);
+        $router3->match('/about');
+
+        $this->assertEquals('/posts/[id]', $router3->getRoute('posts.read')->getPath());
+        $this->assertEquals(Vector {'users.read', 'posts.read', 'blog', 'module'}, $router3->getRoutes()->keys());
+        $this->assertEquals($router1->getFingerprint(), $router3->getFingerprint());
+    }
+
+    public function testCachingPartitionNotCached() {
+        $storage = new MemoryStorage();
+
+        $router1 = new Router();
+        $router1->setStorage($storage);
+        $router1->map('users.read', new Route('/users/[id]', 'Users@read'));
+        $router1->match('/users/1');
+
+        // The code mapped routes are indexed before the cache is loaded
+        $router2 = new Router();
+        $router2->setStorage($storage);
+        $router2->map('about', new Route('/about/{page}', 'Pages@about'));
+
+        $this->assertEquals(Vector {'about'}, $router2->getMethodRoutes('GET')->keys());
+        $this->assertEquals('/users/[id]', $router2->match('/users/1')->getPath());
+        $this->assertTrue($router2->isCached());
+        $this->assertEquals(Vector {'users.read'}, $router2->getMethodRoutes('GET')->keys());
+    }
+
+    /**
+     * @expectedException \Titon\Route\Exception\NoMatchException
+     */
+    public function testCachingPartitionNotCachedReplacesMappedRoutes() {
+        $storage = new MemoryStorage();
+
+        $router1 = new Router();
+        $router1->setStorage($storage);
+        $router1->map('users.read', new Route('/users/[id]', 'Users@read'));
+        $router1->match('/users/1');
+
+        $router2 = new Router();
+        $router2->setStorage($storage);
+        $router2->map('about', new Route('/about/{page}', 'Pages@about'));
+        $router2->match('/about/contact');
+    }
+
     public function testFilters() {
         $stub = new FilterStub();
 
@@ -117,6 +195,107 @@ class RouterTest extends TestCase {
         $this->assertEquals(2, $count);
     }
 
+    public function testFilterShortCircuits() {
+        $router = new Router();
+        $count = 0;
+
+        $router->filterCallback('deny', function() {
+            return 'denied';
+        });
+        $router->filterCallback('count', function() use (&$count) {
+            $count++;
+        });
+
+        $router->map('f1', (new Route('/f1', 'Controller@action'))->setFilters(Vector {'count', 'deny', 'count'}));
+        $router->map('f2', (new Route('/f2', 'Controller@action'))->setFilters(Vector {'count'}));
+
+        $router->match('/f1');
+
+        $this->assertEquals(1, $count);
+        $this->assertEquals('denied', $router->getFilterResponse());
+
+        $router->match('/f2');
+
+        $this->assertEquals(2, $count);
+        $this->assertEquals(null, $router->getFilterResponse());
+    }
+
+    public function testFilterShortCircuitsDispatch() {
+        $router = new Router();
+        $observed = false;
+
+        $router->filterCallback('deny', function() {
+            return 'denied';
+        });
+        $router->on('route.matched', function() use (&$observed) {
+            $observed = true;
+        });
+
+        $router->map('f1', (new Route('/f1', 'Controller@action'))->addFilter('deny'));
+
+        // Short-circuiting does not stop other observers
+        $this->assertEquals('denied', $router->match('/f1')->dispatch());
+        $this->assertTrue($observed);
+    }
+
+    public function testFilterRunsAfterObservers() {
+        $router = new Router();
+        $order = [];
+
+        $router->filterCallback('test', function() use (&$order) {
+            $order[] = 'filter';
+        });
+        $router->on('route.matched', function() use (&$order) {
+            $order[] = 'observer';
+        });
+
+        $router->map('f1', (new Route('/f1', 'Controller@action'))->addFilter('test'));
+        $router->match('/f1');
+
+        $this->assertEquals(['observer', 'filter'], $order);
+    }
+
+    public function testFilterAsync() {
+        $router = new Router();
+        $router->filterAsync('auth', new AsyncFilterStub());
+        $router->filterAsyncCallback('user', async function() {
+            return null;
+        });
+
+        $router->map('f1', (new Route('/f1', 'Controller@action'))->setFilters(Vector {'user', 'auth'}));
+        $router->match('/f1');
+
+        $this->assertEquals('denied', $router->getFilterResponse());
+    }
+
+    public function testGetPipeline() {
+        $this->object->filter('foo', new FilterStub());
+        $this->object->filterAsync('bar', new AsyncFilterStub());
+
+        $route1 = (new Route('/f1', 'Controller@action'))->setFilters(Vector {'foo', 'bar'});
+        $route2 = (new Route('/f2', 'Controller@action'))->setFilters(Vector {'foo', 'bar'});
+
+        $pipeline = $this->object->getPipeline($route1);
+
+        $this->assertEquals(2, $pipeline->count());
+        $this->assertTrue($pipeline->isAsync());
+
+        // Resolved once per filter chain
+        $this->assertSame($pipeline, $this->object->getPipeline($route2));
+
+        // Mapping a filter resets the pipelines
+        $this->object->filter('baz', new FilterStub());
+
+        $this->assertNotSame($pipeline, $this->object->getPipeline($route2));
+    }
+
+    /**
+     * @expectedException \Titon\Route\Exception\MissingFilterException
+     */
+    public function testGetPipelineMissingFilter() {
+        $this->object->getPipeline((new Route('/f1', 'Controller@action'))->addFilter('missing'));
+    }
+
     /**
      * @expectedException \Exception
      */
@@ -329,6 +508,191 @@ class RouterTest extends TestCase {
         $this->object->match('/path~tilde');
     }
 
+    public function testFingerprint() {
+        $fingerprint = $this->object->getFingerprint();
+
+        $this->assertEquals($fingerprint, $this->object->getFingerprint());
+
+        $this->object->map('users', new Route('/users', 'Users@index'));
+
+        $this->assertNotEquals($fingerprint, $this->object->getFingerprint());
+    }
+
+    public function testMatchCache() {
+        $cache = new MatchCache();
+
+        $this->object->setMatchCache($cache);
+
+        $route = $this->object->match('/users/profile');
+
+        $this->assertEquals(1, $cache->count());
+        $this->assertEquals(shape(
+            'route' => 'controller',
+            'url' => '/users/profile',
+            'params' => ['module' => 'users', 'controller' => 'profile']
+        ), $cache->get($this->object->getFingerprint(), 'get:http:/users/profile'));
+
+        // Matcher is skipped on a hit
+        $this->object->setMatcher(new MatcherStub());
+
+        $this->assertSame($route, $this->object->match('/users/profile'));
+        $this->assertEquals(Map {'module' => 'users', 'controller' => 'profile'}, $route->getParams());
+    }
+
+    public function testMatchCacheKeepsParamTypes() {
+        $router = new Router();
+        $router->setMatchCache(new MatchCache());
+        $router->map('posts', new Route('/posts/[id]/{slug?}', 'Posts@read'));
+
+        $params = $router->match('/posts/5')->getParams();
+
+        $this->assertSame(5, $params['id']);
+        $this->assertSame(null, $params['slug']);
+
+        // Matcher is skipped on a hit
+        $router->setMatcher(new MatcherStub());
+
+        $params = $router->match('/posts/5')->getParams();
+
+        $this->assertSame(5, $params['id']);
+        $this->assertSame(null, $params['slug']);
+    }
+
+    public function testMatchCacheKeyedBySecurePort() {
+        $cache = new MatchCache();
+
+        $_SERVER['SERVER_PORT'] = 443;
+        Server::initialize($_SERVER);
+
+        $this->object->setMatchCache($cache);
+        $this->object->match('/users/profile');
+
+        $this->assertNotEquals(null, $cache->get($this->object->getFingerprint(), 'get:https:/users/profile'));
+        $this->assertEquals(null, $cache->get($this->object->getFingerprint(), 'get:http:/users/profile'));
+    }
+
+    /**
+     * @expectedException \Titon\Route\Exception\NoMatchException
+     */
+    public function testMatchCacheKeyedByMethod() {
+        $this->object->setMatchCache(new MatchCache());
+        $this->object->match('/users/profile');
+        $this->object->setMatcher(new MatcherStub());
+
+        $_SERVER['REQUEST_METHOD'] = 'POST';
+        Server::initialize($_SERVER);
+
+        $this->object->match('/users/profile');
+    }
+
+    public function testMatchCacheInvalidatedByFingerprint() {
+        $cache = new MatchCache();
+
+        $this->object->setMatchCache($cache);
+        $this->object->match('/users');
+
+        $this->assertEquals(1, $cache->count());
+
+        $this->object->map('users', new Route('/users', 'Users@index'));
+
+        $this->assertEquals('/users', $this->object->match('/users')->getPath());
+        $this->assertEquals(1, $cache->count());
+    }
+
+    public function testMatchCacheSkipsConditions() {
+        $cache = new MatchCache();
+
+        $this->object->setMatchCache($cache);
+        $this->object->map('cond', (new Route('/cond', 'Controller@action'))->addCondition(($route) ==> true));
+        $this->object->match('/cond');
+
+        $this->assertEquals(0, $cache->count());
+    }
+
+    public function testMatchCacheSkipsRoutesAfterConditions() {
+        $cache = new MatchCache();
+        $enabled = false;
+
+        $router = new Router();
+        $router->setMatchCache($cache);
+        $router->map('beta', (new Route('/dashboard', 'Beta@dashboard'))->addCondition(function($route) use (&$enabled) {
+            return $enabled;
+        }));
+        $router->map('dashboard', new Route('/dashboard', 'Dashboard@index'));
+
+        $this->assertEquals('Dashboard', $router->match('/dashboard')->getAction()['class']);
+        $this->assertEquals(0, $cache->count());
+
+        $enabled = true;
+
+        $this->assertEquals('Beta', $router->match('/dashboard')->getAction()['class']);
+    }
+
+    public function testMatchStaticRouteByPath() {
+        $router = new Router();
+        $router->map('users', new Route('/users', 'Controller@action'));
+        $router->map('module', new Route('/{module}', 'Controller@action'));
+
+        $this->assertEquals('/users', $router->match('/users')->getPath());
+        $this->assertEquals('/users', $router->match('/Users/')->getPath());
+        $this->assertEquals('/{module}', $router->match('/posts')->getPath());
+    }
+
+    public function testMatchStaticRouteKeepsMappingOrder() {
+        $router = new Router();
+        $router->map('module', new Route('/{module}', 'Controller@action'));
+        $router->map('users', new Route('/users', 'Controller@action'));
+        $router->map('posts.read', new Route('/posts/[id]', 'Controller@action'));
+        $router->map('posts', new Route('/posts/list', 'Controller@action'));
+
+        // The first mapped route wins, even if a later route is static
+        $this->assertEquals('/{module}', $router->match('/users')->getPath());
+        $this->assertEquals('/posts/list', $router->match('/posts/list')->getPath());
+        $this->assertEquals('/posts/[id]', $router->match('/posts/1')->getPath());
+    }
+
+    public function testMapIndexesFluentChanges() {
+        $router = new Router();
+        $router->map('users', new Route('/users/{id}', 'Controller@action'))->setMethods(Vector {'post'});
+        $router->map('about', new Route('/{page}', 'Controller@action'))->prepend('/about');
+
+        $this->assertEquals(Vector {'about'}, $router->getMethodRoutes('get')->keys());
+        $this->assertEquals(Vector {'users', 'about'}, $router->getMethodRoutes('post')->keys());
+        $this->assertEquals('/about/{page}', $router->match('/about/team')->getPath());
+    }
+
+    public function testMatchStaticRouteFallsThroughOnMethod() {
+        $router = new Router();
+        $router->post('users.create', new Route('/users', 'Controller@action'));
+        $router->map('module', new Route('/{module}', 'Controller@action'));
+
+        $this->assertEquals('/{module}', $router->match('/users')->getPath());
+
+        $_SERVER['REQUEST_METHOD'] = 'POST';
+        Server::initialize($_SERVER);
+
+        $this->assertEquals('/users', $router->match('/users')->getPath());
+    }
+
+    public function testMethodRoutes() {
+        $router = new Router();
+        $router->map('any1', new Route('/any/{id}', 'Controller@action'));
+        $router->get('get', new Route('/get/{id}', 'Controller@action'));
+        $router->map('any2', new Route('/any/{id}/{action}', 'Controller@action'));
+        $router->http('both', Vector {'get', 'post'}, new Route('/both/{id}', 'Controller@action'));
+        $router->map('static', new Route('/static', 'Controller@action'));
+
+        $this->assertEquals(Vector {'any1', 'get', 'any2', 'both'}, $router->getMethodRoutes('GET')->keys());
+        $this->assertEquals(Vector {'any1', 'any2', 'both'}, $router->getMethodRoutes('post')->keys());
+        $this->assertEquals(Vector {'any1', 'any2'}, $router->getMethodRoutes('delete')->keys());
+
+        // Remapping keeps the order
+        $router->post('any1', new Route('/any/{id}', 'Controller@action'));
+
+        $this->assertEquals(Vector {'get', 'any2', 'both'}, $router->getMethodRoutes('get')->keys());
+        $this->assertEquals(Vector {'any1', 'any2', 'both'}, $router->getMethodRoutes('post')->keys());
+    }
+
     public function testParseAction() {
         $this->assertEquals(shape(
             'class' => 'Controller',
@@ -596,8 +960,20 @@ class RouterTest extends TestCase {
 }
 
 class FilterStub implements Filter {
-    public function filter(Router $router, Route $route): void {
-        return;
+    public function filter(Router $router, Route $route): mixed {
+        return null;
+    }
+}
+
+class AsyncFilterStub implements AsyncFilter {
+    public async function filter(Router $router, Route $route): Awaitable<mixed> {
+        return 'denied';
+    }
+}
+
+class MatcherStub implements Matcher {
+    public function match(string $url, RouteMap $routes): ?Route {
+        return null;
     }
 }
 
@@ -88,15 +88,61 @@ class UrlBuilderTest extends TestCase {
         $this->assertEquals('/users/profile/feed.json', link_to('action.ext', Map {'module' => 'users', 'controller' => 'profile', 'action' => 'feed', 'ext' => 'json'}));
     }
 
-    public function testBuildCaching() {
-        $this->assertFalse($this->object->hasCache('Titon\Route\UrlBuilder::build-module-97a181b0b36bd36f504742ea2acd6746'));
+    public function testBuildMany() {
+        $this->assertEquals(Vector {
+            '/users/profile?page=2',
+            '/users/settings?page=2',
+            '/users/download-center?page=2'
+        }, $this->object->buildMany('controller', Vector {
+            Map {'module' => 'users', 'controller' => 'profile'},
+            Map {'module' => 'users', 'controller' => 'settings'},
+            Map {'module' => 'users', 'controller' => 'download_center'}
+        }, Map {'page' => 2}));
+    }
+
+    /**
+     * @expectedException \Titon\Route\Exception\MissingTokenException
+     */
+    public function testBuildManyMissingToken() {
+        $this->object->buildMany('controller', Vector {
+            Map {'module' => 'users', 'controller' => 'profile'},
+            Map {'module' => 'users'}
+        });
+    }
+
+    public function testBuildCapacity() {
+        $builder = new UrlBuilder($this->object->getRouter(), 2);
+
+        $this->assertEquals(2, $builder->getCapacity());
+        $this->assertEquals('/users/profile', $builder->build('controller', Map {'module' => 'users', 'controller' => 'profile'}));
+        $this->assertEquals('/users/settings', $builder->build('controller', Map {'module' => 'users', 'controller' => 'settings'}));
+        $this->assertEquals('/posts', $builder->build('module', Map {'module' => 'posts'}));
+        $this->assertEquals('/users/profile', $builder->build('controller', Map {'module' => 'users', 'controller' => 'profile'}));
+    }
 
+    public function testGetTemplate() {
+        $this->object->getRouter()->map('blog.archives', new TestRoute('/blog/[year]/[month]/[day?]', 'Module\Controller@action'));
+
+        $template = $this->object->getTemplate('action.ext');
+
+        $this->assertEquals(Vector {'/', '/', '/', '.', ''}, $template['literals']);
+        $this->assertEquals(Vector {'module', 'controller', 'action', 'ext'}, $template['slots']);
+
+        $template = $this->object->getTemplate('blog.archives');
+
+        $this->assertEquals(Vector {'/blog/', '/', '/', ''}, $template['literals']);
+        $this->assertEquals(Vector {'year', 'month', 'day'}, $template['slots']);
+
+        // Templates are compiled once
+        $this->assertSame($template, $this->object->getTemplate('blog.archives'));
+    }
+
+    public function testGetTemplateRecompiledWhenRemapped() {
         $this->assertEquals('/users', $this->object->build('module', Map {'module' => 'users'}));
 
-        $this->assertTrue($this->object->hasCache('Titon\Route\UrlBuilder::build-module-97a181b0b36bd36f504742ea2acd6746'));
+        $this->object->getRouter()->map('module', new TestRoute('/module/{module}', 'Module\Controller@action'));
 
-        $this->assertEquals('/users?foo=bar', $this->object->build('module', Map {'module' => 'users'}, Map {'foo' => 'bar'}));
-        $this->assertEquals('/users?foo=baz', $this->object->build('module', Map {'module' => 'users'}, Map {'foo' => 'baz'}));
+        $this->assertEquals('/module/users', $this->object->build('module', Map {'module' => 'users'}));
     }
 
     /**
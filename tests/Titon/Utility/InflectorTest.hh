@@ -86,6 +86,13 @@ class InflectorTest extends TestCase {
         $this->assertEquals('lots-of-white-space', Inflector::route('lots  of     white space'));
     }
 
+    public function testRouteUncached() {
+        $this->assertEquals('under-score', Inflector::routeUncached('under_score'));
+        $this->assertEquals('with-ext.xml', Inflector::routeUncached('with EXT.xml'));
+        $this->assertEquals('lots-of-white-space', Inflector::routeUncached('lots  of     white space'));
+        $this->assertEquals(Inflector::route('StuDly CaSe'), Inflector::routeUncached('StuDly CaSe'));
+    }
+
     public function testSlug() {
         $this->assertEquals('this-is-a-string-with-studly-case', Inflector::slug('This is A sTring wIth sTudly cAse'));
         $this->assertEquals('andthisonehasunderscores', Inflector::slug('and_this_ONE_has_underscores'));
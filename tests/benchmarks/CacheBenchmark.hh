@@ -0,0 +1,119 @@
+<?hh
+namespace Titon\Cache;
+
+use Titon\Cache\Exception\MissingItemException;
+use Titon\Cache\Serializer\IgbinarySerializer;
+use Titon\Cache\Serializer\JsonSerializer;
+use Titon\Cache\Serializer\PhpSerializer;
+use Titon\Cache\Serializer\RawSerializer;
+use Titon\Cache\Storage\FileSystemStorage;
+use Titon\Cache\Storage\MemoryStorage;
+use Titon\Test\BenchmarkSuite;
+
+/**
+ * Benchmarks the cache miss path, which is hit on every key of a cold cache.
+ * The `miss.exception` benchmark detects a miss by catching the exception thrown by `get()`,
+ * which is how `getItem()` used to work, while `miss.tryGet` uses the exception free `tryGet()`.
+ *
+ * Also benchmarks encoding and decoding typical values, a rendered template, a route table, and a user record,
+ * with every serializer, with and without compression. The payload sizes are listed after the results.
+ */
+class CacheBenchmark extends BenchmarkSuite {
+
+    protected Map<string, int> $_sizes = Map {};
+
+    public function run(): void {
+        $this->runMisses();
+        $this->runSerializers();
+    }
+
+    public function runMisses(): void {
+        $storage = new MemoryStorage();
+        $iterations = 100000;
+
+        $storage->set('hit', ['username' => 'Titon'], strtotime('+1 hour'));
+
+        $this->measure('miss.exception', $iterations, (int $i) ==> {
+            try {
+                return new HitItem('miss', $storage->get('miss'));
+            } catch (MissingItemException $e) {
+                return new MissItem('miss');
+            }
+        });
+
+        $this->measure('miss.tryGet', $iterations, (int $i) ==> $storage->tryGet('miss') ?: new MissItem('miss'));
+        $this->measure('miss.getItem', $iterations, (int $i) ==> $storage->getItem('miss'));
+        $this->measure('miss.has', $iterations, (int $i) ==> $storage->has('miss'));
+        $this->measure('miss.store', $iterations, (int $i) ==> $storage->store('miss.' . $i, () ==> $i));
+
+        $this->measure('hit.getItem', $iterations, (int $i) ==> $storage->getItem('hit'));
+        $this->measure('hit.store', $iterations, (int $i) ==> $storage->store('hit', () ==> $i));
+    }
+
+    public function runSerializers(): void {
+        $storage = new SerializerBenchmarkStorage(sys_get_temp_dir() . '/titon-cache-benchmark/');
+        $iterations = 1000;
+
+        $values = Map {
+            'template' => str_repeat('<div class="row"><a href="/users/123">Titon</a><span>Lorem ipsum dolor sit amet</span></div>', 300),
+            'routes' => array_map(
+                (int $i) ==> ['path' => '/module' . $i . '/{id}/[slug]', 'method' => ['GET', 'POST'], 'action' => ['class' => 'Module' . $i . 'Controller', 'action' => 'view'], 'pattern' => [], 'filters' => ['auth']],
+                range(1, 200)),
+            'user' => ['id' => 123, 'username' => 'titon', 'email' => 'titon@example.com', 'active' => true, 'roles' => ['admin', 'user']]
+        };
+
+        $serializers = Map {
+            'php' => new PhpSerializer(),
+            'json' => new JsonSerializer(),
+            'raw' => new RawSerializer()
+        };
+
+        if (IgbinarySerializer::isAvailable()) {
+            $serializers['igbinary'] = new IgbinarySerializer();
+        }
+
+        foreach ($serializers as $serializerName => $serializer) {
+            foreach ([0, 1024] as $threshold) {
+                $storage->setSerializer($serializer)->setCompression($threshold);
+
+                foreach ($values as $valueName => $value) {
+                    $name = sprintf('%s.%s%s', $serializerName, $valueName, $threshold ? '.gz' : '');
+                    $payload = $storage->encode($value);
+
+                    $this->_sizes[$name] = strlen($payload);
+
+                    $this->measure('encode.' . $name, $iterations, (int $i) ==> $storage->encode($value));
+                    $this->measure('decode.' . $name, $iterations, (int $i) ==> $storage->decode($payload));
+                }
+            }
+        }
+
+        $storage->flush();
+    }
+
+    public function output(): string {
+        $output = parent::output() . PHP_EOL;
+
+        foreach ($this->_sizes as $name => $size) {
+            $output .= sprintf("%-50s %10s bytes\n", 'size.' . $name, number_format($size));
+        }
+
+        return $output;
+    }
+
+}
+
+/**
+ * Exposes the serialization layer of a storage, so it can be measured without I/O.
+ */
+class SerializerBenchmarkStorage extends FileSystemStorage {
+
+    public function decode(string $payload): mixed {
+        return $this->_unserialize($payload);
+    }
+
+    public function encode(mixed $value): string {
+        return $this->_serialize($value);
+    }
+
+}
@@ -0,0 +1,46 @@
+<?hh
+namespace Titon\Event;
+
+use Titon\Test\BenchmarkSuite;
+
+/**
+ * Benchmarks emitting events with no observers, and with increasing numbers of sync and async observers.
+ * The `dispatch.none` benchmark runs the full dispatch cycle for an event without observers,
+ * which is the cost `emit.none` avoids with its fast path.
+ */
+class EventBenchmark extends BenchmarkSuite {
+
+    public function run(): void {
+        $emitter = new Emitter();
+        $iterations = 100000;
+
+        // Events without observers, like most view and controller events
+        $this->measure('emit.none', $iterations, (int $i) ==> $emitter->emit('event.none', [$i]));
+        $this->measure('dispatch.none', $iterations, (int $i) ==> $emitter->dispatch(new Event('event.none'), [$i]));
+        $this->measure('emitMany.none', $iterations, (int $i) ==> $emitter->emitMany('event.none event.other', [$i]));
+
+        foreach ([1, 5, 20] as $count) {
+            $key = 'event.sync.' . $count;
+
+            for ($o = 0; $o < $count; $o++) {
+                $emitter->register($key, (Event $event, int $i) ==> null);
+            }
+
+            $this->measure(sprintf('emit.sync.%s', $count), (int) ($iterations / $count), (int $i) ==> $emitter->emit($key, [$i]));
+        }
+
+        foreach ([1, 5] as $count) {
+            $key = 'event.async.' . $count;
+
+            for ($o = 0; $o < $count; $o++) {
+                $emitter->register($key, async (Event $event, int $i) ==> null);
+            }
+
+            $this->measure(sprintf('emit.async.%s', $count), (int) ($iterations / $count / 10), (int $i) ==> $emitter->emit($key, [$i]));
+        }
+
+        // Reading the call stack of an event that was not dispatched
+        $this->measure('event.callStack', $iterations, (int $i) ==> (new Event('event.none'))->getCallStack());
+    }
+
+}
@@ -0,0 +1,92 @@
+<?hh
+namespace Titon\Route;
+
+use Titon\Route\Matcher\CombinedRegexMatcher;
+use Titon\Route\Matcher\LoopMatcher;
+use Titon\Route\Matcher\RadixMatcher;
+use Titon\Test\BenchmarkSuite;
+
+/**
+ * Benchmarks route compilation and matching against synthetic route tables of increasing size.
+ * Tables mix static, {token}, [int] and optional routes, and every matcher is run against
+ * the first, middle and last mapped route, as well as a URL that matches nothing.
+ */
+class RouteBenchmark extends BenchmarkSuite {
+
+    public function run(): void {
+        foreach ([10, 100, 1000, 10000] as $count) {
+            $this->runTable($count);
+        }
+    }
+
+    public function runTable(int $count): void {
+        // Compile cost per route, and memory retained by the compiled table
+        $routes = $this->generateRoutes($count);
+        $list = $routes->values();
+
+        $this->measure(sprintf('compile.%s', $count), $count, (int $i) ==> $list[$i]->compile());
+
+        $urls = Map {
+            'first' => $this->generateUrl(0),
+            'middle' => $this->generateUrl((int) floor($count / 2)),
+            'last' => $this->generateUrl($count - 1),
+            'miss' => '/missing/path/to/nowhere'
+        };
+
+        $matchers = Map {
+            'loop' => new LoopMatcher(),
+            'radix' => new RadixMatcher(),
+            'combined' => new CombinedRegexMatcher()
+        };
+
+        // Keep the total amount of work per benchmark roughly equal
+        $iterations = (int) max(10, min(10000, 1000000 / $count));
+
+        foreach ($matchers as $name => $matcher) {
+            $this->measure(sprintf('%s.build.%s', $name, $count), 1, (int $i) ==> $matcher->match('/', $routes));
+
+            foreach ($urls as $position => $url) {
+                $this->measure(sprintf('%s.%s.%s', $name, $position, $count), $iterations, (int $i) ==> $matcher->match($url, $routes));
+            }
+        }
+    }
+
+    public function generateRoutes(int $count): RouteMap {
+        $routes = Map {};
+
+        for ($i = 0; $i < $count; $i++) {
+            switch ($i % 4) {
+                case 0:
+                    $path = sprintf('/static%s/page', $i);
+                break;
+                case 1:
+                    $path = sprintf('/token%s/{slug}', $i);
+                break;
+                case 2:
+                    $path = sprintf('/int%s/[id]', $i);
+                break;
+                default:
+                    $path = sprintf('/optional%s/{slug}/[page?]', $i);
+                break;
+            }
+
+            $routes['route' . $i] = new Route($path, 'Controller@action');
+        }
+
+        return $routes;
+    }
+
+    public function generateUrl(int $i): string {
+        switch ($i % 4) {
+            case 0:
+                return sprintf('/static%s/page', $i);
+            case 1:
+                return sprintf('/token%s/hello-world', $i);
+            case 2:
+                return sprintf('/int%s/12345', $i);
+            default:
+                return sprintf('/optional%s/hello-world', $i);
+        }
+    }
+
+}
@@ -0,0 +1,54 @@
+<?hh
+/**
+ * Runs a benchmark suite, prints the results, and writes them as JSON.
+ * If a baseline exists for the suite, regressions against it are reported.
+ *
+ *      hhvm tests/benchmarks/run.hh <suite> [output] [baseline] [tolerance]
+ */
+
+date_default_timezone_set('UTC');
+
+require dirname(dirname(__DIR__)) . '/vendor/autoload.php';
+
+$suite = isset($argv[1]) ? $argv[1] : 'Route';
+$output = isset($argv[2]) ? $argv[2] : __DIR__ . '/../tmp/' . strtolower($suite) . '-benchmark.json';
+$baseline = isset($argv[3]) ? $argv[3] : __DIR__ . '/baselines/' . strtolower($suite) . '.json';
+$tolerance = isset($argv[4]) ? (float) $argv[4] : 0.1;
+
+require_once __DIR__ . '/' . $suite . 'Benchmark.hh';
+
+// Routes and requests depend on the server state
+$_SERVER = array_merge($_SERVER, [
+    'HTTP_HOST' => 'localhost',
+    'DOCUMENT_ROOT' => '/root',
+    'SCRIPT_FILENAME' => '/root/index.php',
+    'REQUEST_METHOD' => 'GET',
+    'REQUEST_URI' => '/',
+    'HTTPS' => 'off'
+]);
+
+Titon\Utility\State\Server::initialize($_SERVER);
+
+$class = 'Titon\\' . $suite . '\\' . $suite . 'Benchmark';
+$benchmark = new $class();
+$benchmark->run();
+
+echo $benchmark->output();
+
+if (!is_dir(dirname($output))) {
+    mkdir(dirname($output), 0755, true);
+}
+
+$benchmark->write($output);
+
+echo PHP_EOL . 'Results written to ' . $output . PHP_EOL;
+
+if (file_exists($baseline)) {
+    $regressions = $benchmark->compare(Titon\Test\BenchmarkSuite::loadBaseline($baseline), $tolerance);
+
+    foreach ($regressions as $name => $ratio) {
+        echo sprintf('Regression: %s is %sx slower than the baseline', $name, number_format($ratio, 2)) . PHP_EOL;
+    }
+
+    exit($regressions->count() ? 1 : 0);
+}